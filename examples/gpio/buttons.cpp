@@ -0,0 +1,37 @@
+/**
+ * @file buttons.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Monitors 20 buttons to ground with one event loop and prints every press and release.
+ *        The process sleeps in epoll_wait while no button changes, so it uses no CPU time when idle.
+ * @date 18-10-2026
+ */
+
+#include <iostream>
+
+#include "../../src/gpio/include/gpio_event_loop.hpp"
+
+using namespace pi_zero_peripherals;
+
+int main()
+{
+    gpio_pin_t* buttons[] = { &GPIO4,  &GPIO5,  &GPIO6,  &GPIO7,  &GPIO8,  &GPIO9,  &GPIO10, &GPIO11, &GPIO12, &GPIO13,
+                              &GPIO16, &GPIO17, &GPIO18, &GPIO19, &GPIO20, &GPIO21, &GPIO22, &GPIO23, &GPIO26, &GPIO27 };
+    gpio_event_loop_t event_loop;
+    gpio_config_t config;
+
+    config.bias = GPIOD_LINE_BIAS_PULL_UP;
+    config.event = GPIO_EVENT_BOTH_EDGES;
+
+    for (gpio_pin_t* button : buttons)
+    {
+        button->initialise(config, "buttons");
+        event_loop.add(*button, [](const gpio_event_t& event) {
+            std::cout << event.timestamp.count() << " GPIO" << (int)event.pin_number
+                      << (event.edge == GPIO_EVENT_FALLING_EDGE ? " pressed" : " released") << std::endl;
+        });
+    }
+
+    event_loop.run();
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file gpio_benchmark.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Compares the toggle rate of 8 pins written one by one with gpio_pin_t, all at once with gpio_port_t,
+ *        and all at once through the registers of /dev/gpiomem, and prints the number of open file descriptors.
+ *        Also measures pins that are typed at compile time, suppressed repeated writes and switching the pins
+ *        between input and output.
+ * @date 18-10-2026
+ */
+
+#include <chrono>
+#include <dirent.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "../../src/gpio/include/gpio.hpp"
+#include "../../src/gpio/include/gpio_port.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Pins that are toggled, free on the Pi Zero W header. */
+static const std::vector<uint8_t> PINS = { 5u, 6u, 12u, 13u, 16u, 19u, 20u, 26u };
+/* Duration of each measurement. */
+static constexpr std::chrono::seconds DURATION(2);
+
+/**
+ * @brief Count the open file descriptors of this process.
+ */
+static uint32_t count_open_fds()
+{
+    DIR* directory = opendir("/proc/self/fd");
+    uint32_t count = 0u;
+
+    while (readdir(directory) != nullptr)
+    {
+        count++;
+    }
+
+    closedir(directory);
+
+    /* Without ".", ".." and the descriptor of the directory itself. */
+    return count - 3u;
+}
+
+int main()
+{
+    /* The 54 global pins do not open anything before they are initialised. */
+    std::cout << "Open file descriptors at startup: " << count_open_fds() << std::endl;
+
+    gpio_config_t config;
+    config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+    config.output_value = GPIO_STATE_LOW;
+
+    /* One request and one ioctl per pin. */
+    {
+        std::vector<std::unique_ptr<gpio_pin_t>> pins;
+        uint32_t toggles = 0u;
+
+        for (const uint8_t pin_number : PINS)
+        {
+            pins.emplace_back(new gpio_pin_t(pin_number));
+            pins.back()->initialise(config, "gpio_benchmark");
+        }
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            for (auto& pin : pins)
+            {
+                pin->set_value(toggles & 1u);
+            }
+
+            toggles++;
+        }
+
+        std::cout << "Open file descriptors with " << PINS.size() << " pins: " << count_open_fds() << std::endl;
+        std::cout << "Per pin: " << toggles / DURATION.count() << " port toggles/s, "
+                  << toggles * PINS.size() / DURATION.count() << " ioctls/s" << std::endl;
+    }
+
+    /* One request for all pins and one ioctl per toggle. */
+    {
+        gpio_port_t port(PINS);
+        uint32_t toggles = 0u;
+
+        port.initialise(config, "gpio_benchmark");
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            port.set_values(toggles & 1u ? 0xFFu : 0x00u);
+            toggles++;
+        }
+
+        std::cout << "Bulk: " << toggles / DURATION.count() << " port toggles/s, "
+                  << toggles / DURATION.count() << " ioctls/s" << std::endl;
+    }
+
+    /* Stores to the GPSET0 and GPCLR0 registers, no system calls. */
+    {
+        gpio_config_t gpiomem_config = config;
+        gpio_port_t port(PINS);
+        uint32_t toggles = 0u;
+
+        gpiomem_config.backend = GPIO_BACKEND_GPIOMEM;
+        port.initialise(gpiomem_config, "gpio_benchmark");
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            port.set_values(toggles & 1u ? 0xFFu : 0x00u);
+            toggles++;
+        }
+
+        std::cout << "Registers: " << toggles / DURATION.count() << " port toggles/s" << std::endl;
+    }
+
+    /* The same stores with the pins known at compile time: one store per pin, no checks. */
+    {
+        gpio_t<5u, GPIOD_LINE_DIRECTION_OUTPUT> led;
+        gpio_t<6u, GPIOD_LINE_DIRECTION_OUTPUT> strobe;
+        uint32_t toggles = 0u;
+
+        static_assert(gpio_distinct<decltype(led), decltype(strobe)>(), "Typed pins must not share a GPIO pin");
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            led.set_value(toggles & 1u);
+            strobe.set_value(toggles & 1u);
+            toggles++;
+        }
+
+        std::cout << "Typed: " << toggles / DURATION.count() << " toggles/s of 2 pins" << std::endl;
+    }
+
+    /* Every other write repeats the last value, e.g. a status LED that is set on every loop, and is suppressed. */
+    {
+        gpio_port_t port(PINS);
+        uint32_t writes = 0u;
+
+        port.initialise(config, "gpio_benchmark");
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            port.set_values(writes & 2u ? 0xFFu : 0x00u);
+            writes++;
+        }
+
+        const gpio_write_counters_t counters = port.get_write_counters();
+
+        std::cout << "Repeated values: " << writes / DURATION.count() << " writes/s, "
+                  << counters.suppressed / DURATION.count() << " suppressed/s" << std::endl;
+    }
+
+    /* Open-drain emulation: release the pins with the pull-up, then drive them low, one request each. */
+    {
+        gpio_config_t released;
+        gpio_config_t driven;
+        gpio_port_t port(PINS);
+        uint32_t switches = 0u;
+
+        released.direction = GPIOD_LINE_DIRECTION_INPUT;
+        released.bias = GPIOD_LINE_BIAS_PULL_UP;
+        driven.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+        driven.output_value = GPIO_STATE_LOW;
+
+        port.initialise(released, "gpio_benchmark");
+
+        const auto end = std::chrono::steady_clock::now() + DURATION;
+
+        while (std::chrono::steady_clock::now() < end)
+        {
+            port.reconfigure(switches & 1u ? released : driven);
+            switches++;
+        }
+
+        std::cout << "Reconfigure: " << switches / DURATION.count() << " direction switches/s" << std::endl;
+    }
+
+    return 0;
+}
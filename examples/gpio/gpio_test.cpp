@@ -0,0 +1,748 @@
+/**
+ * @file gpio_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains tests for the GPIO classes using doctest.
+ *        All pins use the simulated GPIO chip or registers mapped from a file, so no hardware is needed.
+ * @date 18-10-2026
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../lib/doctest/doctest.h"
+
+#include <functional>
+#include <stdlib.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+#include "../../src/gpio/include/gpio.hpp"
+#include "../../src/gpio/include/gpio_capture.hpp"
+#include "../../src/gpio/include/gpio_event_loop.hpp"
+#include "../../src/gpio/include/gpio_port.hpp"
+#include "../../src/gpio/include/gpio_pwm.hpp"
+#include "../../src/gpio/include/gpio_sim_chip.hpp"
+
+using namespace pi_zero_peripherals;
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+
+/**
+ * @brief Get a configuration for a simulated pin.
+ */
+static gpio_config_t sim_config(uint8_t direction, uint8_t bias = GPIOD_LINE_BIAS_AS_IS, uint8_t event = GPIO_EVENT_NONE)
+{
+    gpio_config_t config;
+
+    config.direction = direction;
+    config.bias = bias;
+    config.event = event;
+    config.backend = GPIO_BACKEND_SIMULATED;
+
+    return config;
+}
+
+/**
+ * @brief Create a zeroed temporary file that stands in for /dev/gpiomem.
+ *
+ * @return std::string Name of the file, which the caller removes.
+ */
+static std::string create_register_file()
+{
+    char file_name[] = "/tmp/gpio_test_XXXXXX";
+    const int fd = mkstemp(file_name);
+
+    REQUIRE(fd != -1);
+    REQUIRE(ftruncate(fd, gpio_registers_t::REGISTERS_SIZE) == 0);
+    close(fd);
+
+    return file_name;
+}
+
+/**
+ * @brief Get the function of a pin from the GPFSELn registers.
+ */
+static uint8_t get_function(volatile uint32_t* words, uint8_t pin_number)
+{
+    return (words[gpio_registers_t::GPFSEL0 + pin_number / 10u] >> ((pin_number % 10u) * 3u)) & 0b111u;
+}
+
+TEST_CASE("Test gpio_sim_chip_t")
+{
+    gpio_sim_chip_t chip;
+
+    gpio_set_sim_chip(&chip);
+
+    SUBCASE("Outputs")
+    {
+        gpio_pin_t pin(5u);
+
+        pin.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+        CHECK(chip.is_requested(5u));
+
+        pin.set_value(GPIO_STATE_HIGH);
+        pin.set_value(GPIO_STATE_HIGH);
+        pin.set_value(GPIO_STATE_LOW);
+        pin.force_value(GPIO_STATE_LOW);
+
+        const std::vector<gpio_sim_transition_t> transitions = chip.get_transitions(5u);
+
+        REQUIRE(transitions.size() == 2u);
+        CHECK(transitions[0].value == GPIO_STATE_HIGH);
+        CHECK(transitions[1].value == GPIO_STATE_LOW);
+        CHECK(transitions[1].timestamp >= transitions[0].timestamp);
+        CHECK(chip.get_writes() == 3u);
+        CHECK(pin.get_write_counters().writes == 3u);
+        CHECK(pin.get_write_counters().suppressed == 1u);
+    }
+
+    SUBCASE("Release")
+    {
+        {
+            gpio_pin_t pin(5u);
+
+            pin.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+        }
+
+        CHECK(!chip.is_requested(5u));
+    }
+
+    SUBCASE("Conflicts")
+    {
+        gpio_pin_t pin(5u);
+        gpio_pin_t other(5u);
+        gpio_port_t port({ 4u, 5u });
+
+        pin.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+
+        CHECK_THROWS_AS(other.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT), "test"), std::system_error);
+        CHECK_THROWS_AS(port.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT), "test"), std::system_error);
+
+        /* The port gets all of its pins or none. */
+        CHECK(!chip.is_requested(4u));
+    }
+
+    SUBCASE("Ports")
+    {
+        gpio_port_t port({ 5u, 6u, 7u });
+
+        port.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+
+        /* Bits above the port are ignored. */
+        port.set_values(0b11111101u);
+
+        std::vector<gpio_sim_transition_t> transitions = chip.get_transitions();
+
+        /* Pins of a port change at the same instant. */
+        REQUIRE(transitions.size() == 2u);
+        CHECK(transitions[0].pin_number == 5u);
+        CHECK(transitions[1].pin_number == 7u);
+        CHECK(transitions[0].timestamp == transitions[1].timestamp);
+        CHECK(port.get_values() == 0b101u);
+
+        chip.clear_transitions();
+        port.set_values(0b010u, 0b010u);
+        port.set_values(0b111u);
+
+        transitions = chip.get_transitions();
+
+        REQUIRE(transitions.size() == 1u);
+        CHECK(transitions[0].pin_number == 6u);
+        CHECK(port.get_write_counters().writes == 2u);
+        CHECK(port.get_write_counters().suppressed == 1u);
+    }
+
+    SUBCASE("Inputs")
+    {
+        gpio_pin_t pull_up(17u);
+        gpio_pin_t floating(27u);
+
+        pull_up.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_PULL_UP), "test");
+        floating.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT), "test");
+
+        CHECK(pull_up.get_value() == GPIO_STATE_HIGH);
+        CHECK(floating.get_value() == GPIO_STATE_LOW);
+
+        chip.set_input(17u, GPIO_STATE_LOW);
+        chip.set_input(27u, GPIO_STATE_HIGH);
+
+        CHECK(pull_up.get_value() == GPIO_STATE_LOW);
+        CHECK(floating.get_value() == GPIO_STATE_HIGH);
+    }
+
+    SUBCASE("Concurrent readers")
+    {
+        gpio_pin_t button(17u);
+        uint32_t taken[2] = { 0u, 0u };
+        uint32_t single_reads[2] = { 0u, 0u };
+
+        button.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_AS_IS, GPIO_EVENT_BOTH_EDGES), "test");
+
+        /* Every read blocks until it took an event, also when the other reader took the one it was woken for. */
+        auto reader = [&chip](uint32_t& count, uint32_t& single) {
+            std::vector<gpio_event_t> events;
+
+            for (uint32_t i = 0; i < 50u; i++)
+            {
+                events.clear();
+                single += chip.read_events(17u, events, 1u) == 1u;
+                count += events.size();
+            }
+        };
+        std::thread first(reader, std::ref(taken[0]), std::ref(single_reads[0]));
+        std::thread second(reader, std::ref(taken[1]), std::ref(single_reads[1]));
+
+        for (uint32_t i = 0; i < 100u; i++)
+        {
+            chip.set_input(17u, i % 2u == 0u ? GPIO_STATE_HIGH : GPIO_STATE_LOW);
+        }
+
+        first.join();
+        second.join();
+        CHECK(single_reads[0] + single_reads[1] == 100u);
+        CHECK(taken[0] + taken[1] == 100u);
+    }
+
+    SUBCASE("Reconfigure")
+    {
+        gpio_port_t bus({ 2u, 3u });
+
+        /* Open-drain emulation: released with the pull-up, or driven low. */
+        bus.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_PULL_UP), "test");
+        CHECK(bus.get_values() == 0b11u);
+
+        bus.reconfigure(sim_config(GPIOD_LINE_DIRECTION_OUTPUT));
+        CHECK(bus.get_values() == 0b00u);
+        CHECK(chip.get_transitions().size() == 2u);
+
+        bus.reconfigure(sim_config(GPIOD_LINE_DIRECTION_INPUT));
+        CHECK(bus.get_values() == 0b11u);
+    }
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test gpio_event_loop_t")
+{
+    gpio_sim_chip_t chip;
+    gpio_event_loop_t loop;
+    gpio_pin_t button(17u);
+    gpio_pin_t sensor(27u);
+    std::vector<gpio_event_t> button_events;
+    std::vector<gpio_event_t> sensor_events;
+    const std::vector<gpio_sim_step_t> waveform = {
+        { milliseconds(0), GPIO_STATE_HIGH },
+        { milliseconds(1), GPIO_STATE_LOW },
+        { milliseconds(2), GPIO_STATE_HIGH }
+    };
+
+    gpio_set_sim_chip(&chip);
+    button.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_AS_IS, GPIO_EVENT_BOTH_EDGES), "test");
+    sensor.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_AS_IS, GPIO_EVENT_RISING_EDGE), "test");
+
+    loop.add(button, [&button_events](const gpio_event_t& event) { button_events.push_back(event); });
+    loop.add(sensor, [&sensor_events](const gpio_event_t& event) { sensor_events.push_back(event); });
+
+    CHECK(!button.wait_event(milliseconds(1)));
+    CHECK(loop.run_once(0) == 0u);
+
+    SUBCASE("Edges and timestamps")
+    {
+        chip.play(17u, waveform, seconds(1));
+        chip.play(27u, waveform, seconds(2));
+
+        uint32_t dispatched = 0u;
+
+        for (uint32_t i = 0u; i < 10u && dispatched < 5u; i++)
+        {
+            dispatched += loop.run_once(100);
+        }
+
+        REQUIRE(button_events.size() == 3u);
+        CHECK(button_events[0].edge == GPIO_EVENT_RISING_EDGE);
+        CHECK(button_events[1].edge == GPIO_EVENT_FALLING_EDGE);
+        CHECK(button_events[2].edge == GPIO_EVENT_RISING_EDGE);
+        CHECK(button_events[0].timestamp == seconds(1));
+        CHECK(button_events[2].timestamp == seconds(1) + milliseconds(2));
+        CHECK(button_events[0].pin_number == 17u);
+
+        /* Only rising edges, the falling edge is not reported. */
+        REQUIRE(sensor_events.size() == 2u);
+        CHECK(sensor_events[0].timestamp == seconds(2));
+        CHECK(sensor_events[1].timestamp == seconds(2) + milliseconds(2));
+        CHECK(sensor_events[1].pin_number == 27u);
+    }
+
+    SUBCASE("Burst")
+    {
+        std::vector<gpio_sim_step_t> burst;
+
+        /* More edges than one read returns. */
+        for (uint32_t i = 0u; i < 40u; i++)
+        {
+            burst.push_back({ microseconds(10u * i), (uint8_t)(i % 2u == 0u ? GPIO_STATE_HIGH : GPIO_STATE_LOW) });
+        }
+
+        chip.play(17u, burst, seconds(1));
+
+        for (uint32_t i = 0u; i < 10u && button_events.size() < 40u; i++)
+        {
+            loop.run_once(100);
+        }
+
+        REQUIRE(button_events.size() == 40u);
+
+        for (size_t i = 1; i < button_events.size(); i++)
+        {
+            CHECK(button_events[i].timestamp > button_events[i - 1u].timestamp);
+            CHECK(button_events[i].edge != button_events[i - 1u].edge);
+        }
+
+        CHECK(loop.run_once(0) == 0u);
+    }
+
+    SUBCASE("Stop from another thread")
+    {
+        std::thread stopper([&loop]() {
+            std::this_thread::sleep_for(milliseconds(10));
+            loop.stop();
+        });
+
+        loop.run();
+        stopper.join();
+        CHECK(button_events.empty());
+    }
+
+    SUBCASE("Stop before run")
+    {
+        /* A stop() that comes before run() is not lost. */
+        loop.stop();
+        loop.run();
+
+        loop.reset();
+
+        std::thread stopper([&loop]() {
+            std::this_thread::sleep_for(milliseconds(10));
+            loop.stop();
+        });
+
+        loop.run();
+        stopper.join();
+        CHECK(button_events.empty());
+    }
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test debouncing with event timestamps")
+{
+    /* A button to ground with a pull-up, that bounces when it is pressed and released. */
+    static const std::vector<gpio_sim_step_t> bouncing_press = {
+        { microseconds(0), GPIO_STATE_LOW },
+        { microseconds(100), GPIO_STATE_HIGH },
+        { microseconds(300), GPIO_STATE_LOW },
+        { microseconds(400), GPIO_STATE_HIGH },
+        { microseconds(500), GPIO_STATE_LOW },
+        { microseconds(50000), GPIO_STATE_HIGH },
+        { microseconds(50200), GPIO_STATE_LOW },
+        { microseconds(50300), GPIO_STATE_HIGH }
+    };
+    static constexpr nanoseconds LOCKOUT = milliseconds(5);
+
+    gpio_sim_chip_t chip;
+    gpio_pin_t button(22u);
+    std::vector<gpio_event_t> events;
+    std::vector<gpio_event_t> accepted;
+
+    gpio_set_sim_chip(&chip);
+    button.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_PULL_UP, GPIO_EVENT_BOTH_EDGES), "test");
+    chip.play(22u, bouncing_press, seconds(3));
+
+    while (button.wait_event(nanoseconds(0)))
+    {
+        button.read_events(events);
+    }
+
+    CHECK(events.size() == bouncing_press.size());
+
+    /* Take an edge, then ignore the edges of the lockout time after it. */
+    for (const gpio_event_t& event : events)
+    {
+        if (accepted.empty() || event.timestamp - accepted.back().timestamp >= LOCKOUT)
+        {
+            accepted.push_back(event);
+        }
+    }
+
+    REQUIRE(accepted.size() == 2u);
+    CHECK(accepted[0].edge == GPIO_EVENT_FALLING_EDGE);
+    CHECK(accepted[1].edge == GPIO_EVENT_RISING_EDGE);
+    CHECK(accepted[1].timestamp - accepted[0].timestamp == milliseconds(50));
+    CHECK(button.get_value() == GPIO_STATE_HIGH);
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test gpio_capture_t and gpio_pulse_analyzer_t")
+{
+    gpio_sim_chip_t chip;
+    gpio_pin_t pin(23u);
+    std::vector<gpio_sim_step_t> waveform;
+
+    /* 20 cycles of 1 kHz with a duty cycle of 25%. */
+    for (uint32_t i = 0u; i < 20u; i++)
+    {
+        waveform.push_back({ microseconds(1000u * i), GPIO_STATE_HIGH });
+        waveform.push_back({ microseconds(1000u * i + 250u), GPIO_STATE_LOW });
+    }
+
+    gpio_set_sim_chip(&chip);
+    pin.initialise(sim_config(GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_AS_IS, GPIO_EVENT_BOTH_EDGES), "test");
+
+    gpio_capture_t capture(pin, 64u);
+    gpio_pulse_analyzer_t analyzer(seconds(1));
+    gpio_event_t event;
+
+    capture.start();
+    chip.play(23u, waveform, seconds(10));
+
+    for (uint32_t i = 0u; i < 200u && capture.get_captured() < waveform.size(); i++)
+    {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+
+    capture.stop();
+
+    CHECK(capture.get_captured() == waveform.size());
+    CHECK(capture.get_dropped() == 0u);
+
+    while (capture.pop(event))
+    {
+        analyzer.add(event);
+    }
+
+    CHECK(analyzer.get_cycles() == 19u);
+    CHECK(analyzer.get_period() == microseconds(1000));
+    CHECK(analyzer.get_pulse_width() == microseconds(250));
+    CHECK(analyzer.get_last_pulse_width() == microseconds(250));
+    CHECK(analyzer.get_duty_cycle() == doctest::Approx(0.25));
+    CHECK(analyzer.get_frequency() == doctest::Approx(1000.0));
+
+    /* The cycles stay in the window for a second after the last edge. */
+    analyzer.advance(seconds(10) + milliseconds(500));
+    CHECK(analyzer.get_cycles() == 19u);
+    CHECK(analyzer.get_frequency() == doctest::Approx(1000.0));
+
+    /* The signal stopped: nothing is measured anymore. */
+    analyzer.advance(seconds(12));
+    CHECK(analyzer.get_cycles() == 0u);
+    CHECK(analyzer.get_frequency() == 0.0);
+    CHECK(analyzer.get_period() == nanoseconds(0));
+    CHECK(analyzer.get_pulse_width() == nanoseconds(0));
+    CHECK(analyzer.get_duty_cycle() == 0.0);
+
+    /* A signal that starts again does not measure the gap as a cycle. */
+    analyzer.add({ 23u, GPIO_EVENT_RISING_EDGE, seconds(13) });
+    analyzer.add({ 23u, GPIO_EVENT_FALLING_EDGE, seconds(13) + microseconds(500) });
+    analyzer.add({ 23u, GPIO_EVENT_RISING_EDGE, seconds(13) + microseconds(2000) });
+    CHECK(analyzer.get_cycles() == 1u);
+    CHECK(analyzer.get_period() == microseconds(2000));
+    CHECK(analyzer.get_duty_cycle() == doctest::Approx(0.25));
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test bit-banging")
+{
+    gpio_sim_chip_t chip;
+    gpio_pin_t data(10u);
+    gpio_pin_t clock(11u);
+    const uint8_t bytes[] = { 0xA5u, 0x3Cu, 0xFFu, 0x00u };
+
+    gpio_set_sim_chip(&chip);
+    data.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+    clock.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+
+    /* Shift out MSB first, data changes while the clock is low and is sampled on the rising edge. */
+    for (const uint8_t byte : bytes)
+    {
+        for (int8_t bit = 7; bit >= 0; bit--)
+        {
+            data.set_value((byte >> bit) & 1u);
+            clock.set_value(GPIO_STATE_HIGH);
+            clock.set_value(GPIO_STATE_LOW);
+        }
+    }
+
+    /* Decode the bytes from the recorded transitions, like a logic analyzer. */
+    std::vector<uint8_t> received;
+    uint8_t data_level = GPIO_STATE_LOW;
+    uint8_t byte = 0u;
+    uint8_t bits = 0u;
+
+    for (const gpio_sim_transition_t& transition : chip.get_transitions())
+    {
+        if (transition.pin_number == 10u)
+        {
+            data_level = transition.value;
+        }
+        else if (transition.value == GPIO_STATE_HIGH)
+        {
+            byte = (byte << 1u) | data_level;
+
+            if (++bits == 8u)
+            {
+                received.push_back(byte);
+                bits = 0u;
+            }
+        }
+    }
+
+    REQUIRE(received.size() == sizeof(bytes));
+
+    for (size_t i = 0; i < sizeof(bytes); i++)
+    {
+        CHECK(received[i] == bytes[i]);
+    }
+
+    /* The data pin is only written when it changes. */
+    CHECK(chip.get_transitions(10u).size() == data.get_write_counters().writes);
+    CHECK(data.get_write_counters().writes + data.get_write_counters().suppressed == 8u * sizeof(bytes));
+    CHECK(chip.get_transitions(11u).size() == 2u * 8u * sizeof(bytes));
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test gpio_pwm_t")
+{
+    static constexpr nanoseconds PERIOD = milliseconds(10);
+
+    gpio_sim_chip_t chip;
+    gpio_port_t port({ 12u, 13u, 16u });
+
+    gpio_set_sim_chip(&chip);
+    port.initialise(sim_config(GPIOD_LINE_DIRECTION_OUTPUT), "test");
+
+    {
+        gpio_pwm_t pwm(port, PERIOD);
+
+        pwm.set_duty_cycle(0u, 0.25);
+        pwm.set_duty_cycle(1u, 0.5);
+        pwm.set_duty_cycle(2u, 1.0);
+        pwm.start();
+        std::this_thread::sleep_for(milliseconds(210));
+        pwm.stop();
+
+        CHECK(pwm.get_statistics().periods >= 10u);
+    }
+
+    /* All pins are low after stop(). */
+    CHECK(port.get_values() == 0u);
+
+    const double expected[] = { 0.25, 0.5 };
+
+    for (uint8_t channel = 0u; channel < 2u; channel++)
+    {
+        const std::vector<gpio_sim_transition_t> transitions = chip.get_transitions(channel == 0u ? 12u : 13u);
+        nanoseconds high_time(0);
+        uint32_t pulses = 0u;
+
+        REQUIRE(transitions.size() >= 20u);
+
+        for (size_t i = 0; i + 1u < transitions.size(); i++)
+        {
+            if (transitions[i].value == GPIO_STATE_HIGH)
+            {
+                high_time += transitions[i + 1u].timestamp - transitions[i].timestamp;
+                pulses++;
+            }
+        }
+
+        const std::chrono::duration<double> period = (transitions[transitions.size() - 2u].timestamp - transitions[0].timestamp) / (pulses - 1u);
+        const double duty_cycle = std::chrono::duration<double>(high_time / pulses).count() / period.count();
+
+        /* Wide margins, the thread does not run with a real-time priority here. */
+        CHECK(period.count() == doctest::Approx(0.010).epsilon(0.1));
+        CHECK(duty_cycle == doctest::Approx(expected[channel]).epsilon(0.2));
+    }
+
+    /* A channel that is always on switches on once and off at stop(). */
+    CHECK(chip.get_transitions(16u).size() == 2u);
+
+    gpio_set_sim_chip(nullptr);
+}
+
+TEST_CASE("Test gpio_registers_t")
+{
+    const std::string file_name = create_register_file();
+    gpio_registers_t registers(file_name);
+    volatile uint32_t* words = registers.get_registers();
+    gpio_config_t config;
+
+    /* The mapping stays valid without the file. */
+    unlink(file_name.c_str());
+
+    gpio_set_registers(&registers);
+    config.backend = GPIO_BACKEND_GPIOMEM;
+
+    SUBCASE("Pins")
+    {
+        gpio_pin_t output(5u);
+        gpio_pin_t input(12u);
+
+        config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+        config.output_value = GPIO_STATE_HIGH;
+        output.initialise(config, "test");
+
+        CHECK(get_function(words, 5u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 5u);
+
+        /* GPSETn and GPCLRn are write-only on the chip, so clear them to see the next store. */
+        words[gpio_registers_t::GPSET0] = 0u;
+        output.set_value(GPIO_STATE_LOW);
+        CHECK(words[gpio_registers_t::GPCLR0] == 1u << 5u);
+        CHECK(words[gpio_registers_t::GPSET0] == 0u);
+
+        words[gpio_registers_t::GPCLR0] = 0u;
+        output.set_value(GPIO_STATE_HIGH);
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 5u);
+        CHECK(words[gpio_registers_t::GPCLR0] == 0u);
+
+        /* Only the function of the pin changes, not those of the other pins in the register. */
+        words[gpio_registers_t::GPFSEL0 + 1u] = 0x3FFFFFFFu;
+        config.direction = GPIOD_LINE_DIRECTION_INPUT;
+        input.initialise(config, "test");
+        CHECK(get_function(words, 12u) == GPIO_FUNCTION_INPUT);
+        CHECK(words[gpio_registers_t::GPFSEL0 + 1u] == (0x3FFFFFFFu & ~(0b111u << 6u)));
+
+        words[gpio_registers_t::GPLEV0] = 1u << 12u;
+        CHECK(input.get_value() == GPIO_STATE_HIGH);
+        words[gpio_registers_t::GPLEV0] = ~(1u << 12u);
+        CHECK(input.get_value() == GPIO_STATE_LOW);
+    }
+
+    SUBCASE("Ports")
+    {
+        gpio_port_t outputs({ 4u, 12u, 40u });
+        gpio_port_t inputs({ 7u, 33u });
+
+        config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+        config.output_value = GPIO_STATE_LOW;
+        outputs.initialise(config, "test");
+
+        CHECK(get_function(words, 4u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(get_function(words, 12u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(get_function(words, 40u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(words[gpio_registers_t::GPCLR0] == ((1u << 4u) | (1u << 12u)));
+        CHECK(words[gpio_registers_t::GPCLR0 + 1u] == 1u << 8u);
+
+        /* One store per bank for the pins that go high and one for the pins that go low. */
+        words[gpio_registers_t::GPCLR0] = 0u;
+        words[gpio_registers_t::GPCLR0 + 1u] = 0u;
+        outputs.set_values(0b101u);
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 4u);
+        CHECK(words[gpio_registers_t::GPSET0 + 1u] == 1u << 8u);
+        CHECK(words[gpio_registers_t::GPCLR0] == 1u << 12u);
+        CHECK(words[gpio_registers_t::GPCLR0 + 1u] == 0u);
+
+        config.direction = GPIOD_LINE_DIRECTION_INPUT;
+        inputs.initialise(config, "test");
+        CHECK(get_function(words, 7u) == GPIO_FUNCTION_INPUT);
+        CHECK(get_function(words, 33u) == GPIO_FUNCTION_INPUT);
+
+        words[gpio_registers_t::GPLEV0] = 1u << 7u;
+        words[gpio_registers_t::GPLEV0 + 1u] = 0u;
+        CHECK(inputs.get_values() == 0b01u);
+        words[gpio_registers_t::GPLEV0] = 0u;
+        words[gpio_registers_t::GPLEV0 + 1u] = 1u << 1u;
+        CHECK(inputs.get_values() == 0b10u);
+    }
+
+    gpio_set_registers(nullptr);
+}
+
+/* Typed pins of the tests below. */
+using typed_led_t    = gpio_t<5u, GPIOD_LINE_DIRECTION_OUTPUT>;
+using typed_strobe_t = gpio_t<38u, GPIOD_LINE_DIRECTION_OUTPUT, GPIOD_LINE_BIAS_DISABLE>;
+using typed_button_t = gpio_t<12u, GPIOD_LINE_DIRECTION_INPUT, GPIOD_LINE_BIAS_PULL_UP>;
+
+static_assert(gpio_distinct<>(), "No pins are distinct");
+static_assert(gpio_distinct<typed_led_t>(), "One pin is distinct");
+static_assert(gpio_distinct<typed_led_t, typed_strobe_t, typed_button_t>(), "Different pins are distinct");
+static_assert(!gpio_distinct<typed_led_t, gpio_t<5u, GPIOD_LINE_DIRECTION_INPUT>>(), "Pins with the same number are not distinct");
+static_assert(!gpio_distinct<typed_button_t, typed_led_t, typed_button_t>(), "Repeated pins are not distinct");
+static_assert(!gpio_distinct<typed_strobe_t, gpio_t<38u, GPIOD_LINE_DIRECTION_INPUT>>(), "Pins above 31 are compared too");
+
+TEST_CASE("Test gpio_t")
+{
+    const std::string file_name = create_register_file();
+    gpio_registers_t registers(file_name);
+    volatile uint32_t* words = registers.get_registers();
+
+    unlink(file_name.c_str());
+
+    SUBCASE("Outputs")
+    {
+        typed_led_t led(GPIO_STATE_HIGH, registers);
+
+        /* The value is driven before the pin becomes an output. */
+        CHECK(get_function(words, 5u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 5u);
+
+        words[gpio_registers_t::GPSET0] = 0u;
+        led.set_low();
+        CHECK(words[gpio_registers_t::GPCLR0] == 1u << 5u);
+        CHECK(words[gpio_registers_t::GPSET0] == 0u);
+
+        words[gpio_registers_t::GPCLR0] = 0u;
+        led.set_high();
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 5u);
+        CHECK(words[gpio_registers_t::GPCLR0] == 0u);
+
+        words[gpio_registers_t::GPSET0] = 0u;
+        led.set_value(GPIO_STATE_LOW);
+        CHECK(words[gpio_registers_t::GPCLR0] == 1u << 5u);
+        led.set_value(GPIO_STATE_HIGH);
+        CHECK(words[gpio_registers_t::GPSET0] == 1u << 5u);
+
+        /* Pins above 31 use the second register of each bank. */
+        words[gpio_registers_t::GPPUD] = 0xFFu;
+        words[gpio_registers_t::GPPUDCLK0 + 1u] = 0xFFu;
+
+        typed_strobe_t strobe(GPIO_STATE_LOW, registers);
+
+        CHECK(get_function(words, 38u) == GPIO_FUNCTION_OUTPUT);
+        CHECK(words[gpio_registers_t::GPCLR0 + 1u] == 1u << 6u);
+
+        strobe.set_high();
+        CHECK(words[gpio_registers_t::GPSET0 + 1u] == 1u << 6u);
+
+        /* The pull sequence ends with the control signal and clock off. */
+        CHECK(words[gpio_registers_t::GPPUD] == 0u);
+        CHECK(words[gpio_registers_t::GPPUDCLK0 + 1u] == 0u);
+    }
+
+    SUBCASE("Inputs")
+    {
+        words[gpio_registers_t::GPFSEL0 + 1u] = 0x3FFFFFFFu;
+        words[gpio_registers_t::GPPUD] = 0xFFu;
+        words[gpio_registers_t::GPPUDCLK0] = 0xFFu;
+
+        typed_button_t button(GPIO_STATE_LOW, registers);
+
+        /* Only the function of the pin changes, and the pull sequence ran. */
+        CHECK(words[gpio_registers_t::GPFSEL0 + 1u] == (0x3FFFFFFFu & ~(0b111u << 6u)));
+        CHECK(words[gpio_registers_t::GPPUD] == 0u);
+        CHECK(words[gpio_registers_t::GPPUDCLK0] == 0u);
+        /* An input does not drive a value. */
+        CHECK(words[gpio_registers_t::GPSET0] == 0u);
+        CHECK(words[gpio_registers_t::GPCLR0] == 0u);
+
+        words[gpio_registers_t::GPLEV0] = 1u << 12u;
+        CHECK(button.get_value() == GPIO_STATE_HIGH);
+        words[gpio_registers_t::GPLEV0] = ~(1u << 12u);
+        CHECK(button.get_value() == GPIO_STATE_LOW);
+    }
+}
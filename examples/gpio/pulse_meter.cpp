@@ -0,0 +1,59 @@
+/**
+ * @file pulse_meter.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Measures the signal on GPIO17 (e.g. a fan tachometer or a PWM output) and prints its frequency,
+ *        period, pulse width and duty cycle over the last second, once per second.
+ * @date 18-10-2026
+ */
+
+#include <iostream>
+
+#include "../../src/gpio/include/gpio_capture.hpp"
+
+using namespace pi_zero_peripherals;
+
+int main()
+{
+    gpio_config_t config;
+    gpio_event_t events[256];
+
+    config.event = GPIO_EVENT_BOTH_EDGES;
+    GPIO17.initialise(config, "pulse_meter");
+
+    gpio_capture_t capture(GPIO17, 16384u);
+    gpio_pulse_analyzer_t analyzer(std::chrono::seconds(1));
+    uint64_t dropped = 0u;
+
+    capture.start();
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        for (uint32_t count = capture.pop(events, 256u); count > 0u; count = capture.pop(events, 256u))
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                analyzer.add(events[i]);
+            }
+        }
+
+        /* A gap in the edges makes the next cycle wrong. */
+        if (capture.get_dropped() != dropped)
+        {
+            dropped = capture.get_dropped();
+            analyzer.reset();
+        }
+
+        /* Without edges the window still moves, so a signal that stopped reads as 0 Hz. The steady clock is
+           CLOCK_MONOTONIC, like the timestamps of the events. */
+        analyzer.advance(std::chrono::steady_clock::now().time_since_epoch());
+
+        std::cout << analyzer.get_frequency() << " Hz, period " << analyzer.get_period().count()
+                  << " ns, pulse width " << analyzer.get_pulse_width().count()
+                  << " ns, duty cycle " << analyzer.get_duty_cycle() * 100.0 << " %, "
+                  << capture.get_captured() << " edges captured, " << dropped << " dropped" << std::endl;
+    }
+
+    return 0;
+}
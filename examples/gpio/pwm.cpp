@@ -0,0 +1,51 @@
+/**
+ * @file pwm.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Fades 8 LEDs in and out with software PWM, each with a different phase, and prints the timing of the
+ *        PWM thread once per second.
+ * @date 18-10-2026
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "../../src/gpio/include/gpio_pwm.hpp"
+
+using namespace pi_zero_peripherals;
+
+int main()
+{
+    gpio_port_t leds({ 5u, 6u, 12u, 13u, 16u, 19u, 20u, 26u });
+    gpio_config_t config;
+
+    config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+    leds.initialise(config, "pwm");
+
+    gpio_pwm_t pwm(leds, std::chrono::milliseconds(5));
+
+    pwm.start();
+
+    for (uint32_t step = 0u; true; step++)
+    {
+        for (uint8_t channel = 0u; channel < leds.get_size(); channel++)
+        {
+            const double phase = 2.0 * M_PI * (step / 100.0 + channel / 8.0);
+
+            /* Perceived brightness is roughly quadratic in the duty cycle. */
+            pwm.set_duty_cycle(channel, std::pow(0.5 + 0.5 * std::sin(phase), 2.0));
+        }
+
+        if (step % 50u == 0u)
+        {
+            const gpio_pwm_statistics_t statistics = pwm.get_statistics();
+
+            std::cout << statistics.periods << " periods, " << statistics.writes << " writes, jitter mean "
+                      << statistics.mean_jitter.count() << " ns, max " << statistics.max_jitter.count() << " ns"
+                      << (statistics.realtime ? "" : " (no realtime priority)") << std::endl;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file sim_benchmark.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Measures the overhead of the GPIO classes on the simulated GPIO chip, so it runs on any Linux machine:
+ *        the time of a write, the latency from an edge to its callback in the event loop, and the jitter of
+ *        the PWM thread.
+ * @date 18-10-2026
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include "../../src/gpio/include/gpio_event_loop.hpp"
+#include "../../src/gpio/include/gpio_pwm.hpp"
+#include "../../src/gpio/include/gpio_sim_chip.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Number of writes and edges that are measured. */
+static constexpr uint32_t COUNT = 1000u;
+
+int main()
+{
+    gpio_sim_chip_t chip;
+    gpio_config_t output;
+    gpio_config_t input;
+
+    gpio_set_sim_chip(&chip);
+    gpio_set_default_backend(GPIO_BACKEND_SIMULATED);
+    output.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+    input.event = GPIO_EVENT_BOTH_EDGES;
+
+    /* Writes that change the pin, so none are suppressed. */
+    {
+        gpio_pin_t pin(5u);
+
+        pin.initialise(output, "sim_benchmark");
+
+        const std::chrono::nanoseconds start = gpio_sim_chip_t::now();
+
+        for (uint32_t i = 0u; i < 100u * COUNT; i++)
+        {
+            pin.set_value(i & 1u);
+        }
+
+        std::cout << "Write: " << (gpio_sim_chip_t::now() - start).count() / (100u * COUNT) << " ns" << std::endl;
+    }
+
+    /* Edges 200 us apart, from the edge to the callback. */
+    {
+        gpio_pin_t pin(17u);
+        gpio_event_loop_t loop;
+        std::vector<gpio_sim_step_t> waveform;
+        std::chrono::nanoseconds latency_sum(0);
+        std::chrono::nanoseconds latency_max(0);
+        uint32_t received = 0u;
+
+        pin.initialise(input, "sim_benchmark");
+        loop.add(pin, [&](const gpio_event_t& event) {
+            const std::chrono::nanoseconds latency = gpio_sim_chip_t::now() - event.timestamp;
+
+            latency_sum += latency;
+            latency_max = std::max(latency_max, latency);
+
+            if (++received == COUNT)
+            {
+                loop.stop();
+            }
+        });
+
+        for (uint32_t i = 0u; i < COUNT; i++)
+        {
+            waveform.push_back({ std::chrono::microseconds(200u * (i + 1u)), (uint8_t)(i & 1u ? GPIO_STATE_LOW : GPIO_STATE_HIGH) });
+        }
+
+        std::thread edges(&gpio_sim_chip_t::play_realtime, &chip, 17u, waveform);
+
+        loop.run();
+        edges.join();
+
+        std::cout << "Event loop latency: mean " << (latency_sum / COUNT).count() << " ns, max "
+                  << latency_max.count() << " ns" << std::endl;
+    }
+
+    /* One second of PWM on 8 channels. */
+    {
+        gpio_port_t port({ 5u, 6u, 12u, 13u, 16u, 19u, 20u, 26u });
+
+        port.initialise(output, "sim_benchmark");
+
+        gpio_pwm_t pwm(port, std::chrono::milliseconds(5));
+
+        for (uint8_t channel = 0u; channel < port.get_size(); channel++)
+        {
+            pwm.set_duty_cycle(channel, (channel + 1u) / 9.0);
+        }
+
+        pwm.start();
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        pwm.stop();
+
+        const gpio_pwm_statistics_t statistics = pwm.get_statistics();
+
+        std::cout << "PWM: " << statistics.periods << " periods, " << statistics.writes << " writes, jitter mean "
+                  << statistics.mean_jitter.count() << " ns, max " << statistics.max_jitter.count() << " ns"
+                  << (statistics.realtime ? "" : " (no real-time priority)") << std::endl;
+    }
+
+    gpio_set_sim_chip(nullptr);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file animation_converter.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Converts a sequence of PBM images (P1 or P4) into an SSD1306 animation file.
+ * @date 18-10-2026
+ *
+ * Usage: animation_converter [-r frame_rate] [-n] output_file frame_0.pbm frame_1.pbm ...
+ * -r: default frame rate stored in the file (default: 30).
+ * -n: do not add a loop frame.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string.h>
+#include <unistd.h>
+
+#include "include/ssd1306_animation.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Read the next header token of a PBM file, skipping whitespace and comments.
+ *
+ * @param data Contents of the file.
+ * @param position Position to start reading, set to the position after the token.
+ * @return std::string The token.
+ */
+static std::string read_token(const std::string& data, size_t& position)
+{
+    while (position < data.size())
+    {
+        if (data[position] == '#')
+        {
+            while (position < data.size() && data[position] != '\n')
+            {
+                position++;
+            }
+        }
+        else if (isspace((unsigned char)data[position]))
+        {
+            position++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    const size_t start = position;
+
+    while (position < data.size() && !isspace((unsigned char)data[position]) && data[position] != '#')
+    {
+        position++;
+    }
+
+    return data.substr(start, position - start);
+}
+
+/**
+ * @brief Read a PBM file into a page-major framebuffer.
+ *
+ * @param file_name Name of the PBM file.
+ * @param width Set to the width of the image.
+ * @param height Set to the height of the image.
+ * @param framebuffer Set to the page-major contents of the image.
+ */
+static void read_pbm(const std::string& file_name, size_t& width, size_t& height, std::vector<uint8_t>& framebuffer)
+{
+    std::ifstream file(file_name, std::ios::binary);
+
+    if (!file)
+    {
+        throw ssd1306_animation_exception("could not open " + file_name);
+    }
+
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t position = 0u;
+    const std::string format = read_token(data, position);
+
+    if (format != "P1" && format != "P4")
+    {
+        throw ssd1306_animation_exception(file_name + " is not a PBM file");
+    }
+
+    width = std::stoul(read_token(data, position));
+    height = std::stoul(read_token(data, position));
+
+    if (width == 0u || width > 128u || height == 0u || height > 64u || height % 8u != 0u)
+    {
+        throw ssd1306_animation_exception(file_name + " does not have a valid SSD1306 geometry");
+    }
+
+    framebuffer.assign(width * (height / 8u), 0u);
+
+    /* A single whitespace character separates the header from binary data. */
+    position++;
+
+    for (size_t y = 0; y < height; y++)
+    {
+        for (size_t x = 0; x < width; x++)
+        {
+            bool pixel;
+
+            if (format == "P4")
+            {
+                const size_t index = position + y * ((width + 7u) / 8u) + x / 8u;
+
+                if (index >= data.size())
+                {
+                    throw ssd1306_animation_exception(file_name + " is truncated");
+                }
+
+                pixel = (data[index] >> (7u - x % 8u)) & 1u;
+            }
+            else
+            {
+                const std::string token = read_token(data, position);
+
+                if (token.empty())
+                {
+                    throw ssd1306_animation_exception(file_name + " is truncated");
+                }
+
+                pixel = token[0] == '1';
+
+                /* Pixels in P1 do not need to be separated by whitespace. */
+                if (token.size() > 1u)
+                {
+                    position -= token.size() - 1u;
+                }
+            }
+
+            /* In PBM, 1 is black. Black pixels are turned on. */
+            framebuffer[(y / 8u) * width + x] |= pixel << (y % 8u);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint16_t frame_rate = 30u;
+    bool loop = true;
+    int option;
+
+    while ((option = getopt(argc, argv, "r:n")) != -1)
+    {
+        switch (option)
+        {
+        case 'r':
+            frame_rate = std::stoul(optarg);
+            break;
+        case 'n':
+            loop = false;
+            break;
+        default:
+            std::cerr << "usage: " << argv[0] << " [-r frame_rate] [-n] output_file frame.pbm..." << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc - optind < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " [-r frame_rate] [-n] output_file frame.pbm..." << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        std::vector<uint8_t> framebuffer;
+        size_t width;
+        size_t height;
+
+        read_pbm(argv[optind + 1], width, height, framebuffer);
+
+        ssd1306_animation_writer_t writer(width, height, frame_rate);
+
+        for (int i = optind + 1; i < argc; i++)
+        {
+            size_t frame_width;
+            size_t frame_height;
+
+            read_pbm(argv[i], frame_width, frame_height, framebuffer);
+
+            if (frame_width != width || frame_height != height)
+            {
+                throw ssd1306_animation_exception(std::string(argv[i]) + " has a different size than the first frame");
+            }
+
+            writer.add_frame(framebuffer.data());
+        }
+
+        writer.save(argv[optind], loop);
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
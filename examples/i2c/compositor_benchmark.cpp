@@ -0,0 +1,136 @@
+/**
+ * @file compositor_benchmark.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Runs typical UI update patterns through ssd1306_compositor_t on an emulated 128x64 display and reports
+ *        the bus traffic and compose time of each, next to a full redraw.
+ * @date 18-10-2026
+ */
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string.h>
+
+#include "include/ssd1306_compositor.hpp"
+#include "include/ssd1306_emulator.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Number of updates per pattern. */
+static constexpr uint32_t UPDATES = 1000u;
+
+/**
+ * @brief Run an update pattern and print the average bytes on the bus and time per update.
+ *
+ * @param name Name of the pattern.
+ * @param emulator Emulated display, to count the bytes.
+ * @param update Function that performs one update.
+ */
+static void benchmark(const char* name, ssd1306_emulator_t& emulator, const std::function<void(uint32_t)>& update)
+{
+    emulator.reset_counters();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < UPDATES; i++)
+    {
+        update(i);
+    }
+
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": "
+              << emulator.counters.bytes / UPDATES << " bytes, "
+              << emulator.counters.transactions / UPDATES << " transactions, "
+              << time.count() / UPDATES << " ns per update" << std::endl;
+}
+
+/**
+ * @brief Draw the digit of a tick into a layer: a bar of which the height depends on the tick.
+ */
+static void draw_tick(uint8_t* pixels, uint32_t tick)
+{
+    memset(pixels, 0u, 24u);
+
+    for (size_t x = 0; x < 8u; x++)
+    {
+        pixels[(tick % 3u) * 8u + x] = 0xFFu >> (tick % 8u);
+    }
+}
+
+int main()
+{
+    using display_t = ssd1306_128x64_t;
+
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE);
+    display_t ssd1306(i2c_bus);
+
+    i2c_bus.attach(0b0111100u, emulator);
+    ssd1306.initialise();
+
+    ssd1306_compositor_t<display_t> compositor(ssd1306);
+
+    /* Status bar with a clock in the top right, main area, and a popup in the middle. */
+    const uint8_t main_area = compositor.add_layer(0u, 1u, 128u, 7u, 0u);
+    const uint8_t status_bar = compositor.add_layer(0u, 0u, 104u, 1u, 1u);
+    const uint8_t clock = compositor.add_layer(104u, 0u, 24u, 1u, 1u);
+    const uint8_t popup = compositor.add_layer(16u, 2u, 96u, 4u, 2u);
+    const uint8_t overlay = compositor.add_layer(16u, 2u, 96u, 4u, 3u, ssd1306_compositor_t<display_t>::BLEND_TRANSPARENT);
+
+    memset(compositor.get_pixels(main_area), 0x55u, 128u * 7u);
+    memset(compositor.get_pixels(status_bar), 0x81u, 104u);
+    memset(compositor.get_pixels(popup), 0xFFu, 96u * 4u);
+    compositor.set_visible(popup, false);
+    compositor.set_visible(overlay, false);
+    compositor.compose();
+
+    benchmark("Full redraw", emulator, [&](uint32_t i) {
+        draw_tick(compositor.get_pixels(clock), i);
+        ssd1306.display_framebuffer();
+    });
+
+    benchmark("Clock tick", emulator, [&](uint32_t i) {
+        draw_tick(compositor.get_pixels(clock), i);
+        compositor.damage(clock);
+        compositor.compose();
+    });
+
+    /* The popup covers the main area, so the clock is moved under it. */
+    compositor.move_layer(clock, 40u, 3u);
+    compositor.set_visible(popup, true);
+    compositor.compose();
+
+    benchmark("Clock tick under opaque popup", emulator, [&](uint32_t i) {
+        draw_tick(compositor.get_pixels(clock), i);
+        compositor.damage(clock);
+        compositor.compose();
+    });
+
+    compositor.set_visible(popup, false);
+    compositor.set_visible(overlay, true);
+    compositor.compose();
+
+    benchmark("Clock tick under transparent overlay", emulator, [&](uint32_t i) {
+        draw_tick(compositor.get_pixels(clock), i);
+        compositor.damage(clock);
+        compositor.compose();
+    });
+
+    compositor.set_visible(overlay, false);
+    compositor.set_visible(popup, true);
+    compositor.compose();
+
+    benchmark("Moving popup", emulator, [&](uint32_t i) {
+        compositor.move_layer(popup, i % 32u, 2u);
+        compositor.compose();
+    });
+
+    const ssd1306_compositor_statistics_t statistics = compositor.get_statistics();
+
+    std::cout << statistics.compositions << " compositions, "
+              << statistics.columns_composed << " columns composed, "
+              << statistics.columns_changed << " columns changed" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file dither_benchmark.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Measures the conversion time of all dithering modes for images of various sizes. Does not need a display.
+ * @date 18-10-2026
+ */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "include/ssd1306_dither.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Number of conversions per measurement. */
+static constexpr uint32_t ITERATIONS = 2000u;
+
+int main()
+{
+    const struct { uint8_t width; uint8_t height; } sizes[] = {
+        { 16u, 16u }, { 32u, 32u }, { 96u, 16u }, { 128u, 32u }, { 128u, 64u }
+    };
+    const struct { ssd1306_dither_t::dither_mode mode; const char* name; } modes[] = {
+        { ssd1306_dither_t::DITHER_THRESHOLD, "threshold" },
+        { ssd1306_dither_t::DITHER_ORDERED, "ordered" },
+        { ssd1306_dither_t::DITHER_FLOYD_STEINBERG, "floyd-steinberg" },
+        { ssd1306_dither_t::DITHER_ATKINSON, "atkinson" }
+    };
+
+    std::cout << std::setw(10) << "size" << std::setw(18) << "mode" << std::setw(14) << "us/image" << std::setw(14) << "Mpixel/s" << std::endl;
+
+    for (const auto& size : sizes)
+    {
+        std::vector<uint8_t> image(size.width * size.height);
+        std::vector<uint8_t> framebuffer(size.width * (size.height / 8u));
+        ssd1306_dither_t dither(size.width, size.height);
+
+        /* Diagonal gradient with some texture. */
+        for (size_t y = 0; y < size.height; y++)
+        {
+            for (size_t x = 0; x < size.width; x++)
+            {
+                image[y * size.width + x] = ((x * 255u) / size.width + (y * 255u) / size.height) / 2u ^ ((x * y) & 0x0Fu);
+            }
+        }
+
+        for (const auto& mode : modes)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (size_t i = 0; i < ITERATIONS; i++)
+            {
+                dither.convert(mode.mode, image.data(), size.width, size.height, size.width, framebuffer.data());
+            }
+
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << std::setw(6) << (int)size.width << "x" << std::setw(3) << std::left << (int)size.height << std::right
+                      << std::setw(18) << mode.name
+                      << std::setw(14) << std::fixed << std::setprecision(2) << seconds * 1e6 / ITERATIONS
+                      << std::setw(14) << (double)size.width * size.height * ITERATIONS / seconds / 1e6 << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,1211 @@
+/**
+ * @file emulator_test.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains tests for ssd1306_t and the code on top of it using doctest.
+ *        The display is emulated on a simulated I2C bus, or a mock SPI device with D/C and RST on the simulated
+ *        GPIO chip, so no hardware is needed.
+ * @date 18-10-2026
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../../lib/doctest/doctest.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "include/ssd1306_emulator.hpp"
+#include "include/ssd1306_group.hpp"
+#include "include/ssd1306_animation.hpp"
+#include "include/ssd1306_dither.hpp"
+#include "include/ssd1306_grayscale.hpp"
+#include "include/ssd1306_effects.hpp"
+#include "include/ssd1306_compositor.hpp"
+#include "include/ssd1306_sprite.hpp"
+#include "include/ssd1306_server.hpp"
+#include "include/ssd1306_spi_transport.hpp"
+#include "../../src/gpio/include/gpio_sim_chip.hpp"
+#include "../../src/spi/include/spi_mock_device.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Slave address of a panel with SA0 low. */
+static constexpr uint8_t ADDRESS = 0b0111100u;
+
+/**
+ * @brief Fill a pixel array with a pseudo-random pattern.
+ */
+template <typename DISPLAY>
+static void random_pixels(uint8_t pixels[DISPLAY::SCREEN_HEIGHT][DISPLAY::SCREEN_WIDTH], unsigned int seed)
+{
+    srand(seed);
+
+    for (size_t y = 0; y < DISPLAY::SCREEN_HEIGHT; y++)
+    {
+        for (size_t x = 0; x < DISPLAY::SCREEN_WIDTH; x++)
+        {
+            pixels[y][x] = rand() & 1u;
+        }
+    }
+}
+
+/**
+ * @brief Check that the emulated panel shows exactly the given pixels.
+ */
+template <typename DISPLAY>
+static bool shows(ssd1306_emulator_t& emulator, uint8_t pixels[DISPLAY::SCREEN_HEIGHT][DISPLAY::SCREEN_WIDTH])
+{
+    const std::vector<uint8_t> image = emulator.render();
+
+    for (size_t y = 0; y < DISPLAY::SCREEN_HEIGHT; y++)
+    {
+        for (size_t x = 0; x < DISPLAY::SCREEN_WIDTH; x++)
+        {
+            if (image[y * DISPLAY::SCREEN_WIDTH + x] != pixels[y][x])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Tests ssd1306_t against the emulator.
+ */
+TEST_CASE("Test ssd1306_t on emulator")
+{
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    uint8_t pixels[32][128];
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    /* Test initialisation. */
+    SUBCASE("Initialisation")
+    {
+        CHECK(emulator.state.display_on);
+        CHECK(emulator.state.multiplex_ratio == 32u);
+        CHECK(!emulator.state.com_pins_alternative);
+        CHECK(emulator.state.charge_pump);
+        CHECK(ssd1306.get_display_status() == 1u);
+
+        ssd1306.enable_display(false);
+        CHECK(ssd1306.get_display_status() == 0u);
+    }
+
+    /* Test that the displayed image is pixel-exact. */
+    SUBCASE("Display")
+    {
+        random_pixels<ssd1306_128x32_t>(pixels, 1u);
+        ssd1306.display(pixels);
+        CHECK(shows<ssd1306_128x32_t>(emulator, pixels));
+    }
+
+    /* Test that an unchanged controller state is not sent again. */
+    SUBCASE("Controller state shadow")
+    {
+        random_pixels<ssd1306_128x32_t>(pixels, 2u);
+        ssd1306.display(pixels);
+
+        const uint32_t suppressed = ssd1306.get_suppressed_commands();
+        emulator.reset_counters();
+        ssd1306.display(pixels);
+
+        /* Four messages of 128 data bytes, no setup commands. */
+        CHECK(emulator.counters.transactions == 4u);
+        CHECK(emulator.counters.command_bytes == 0u);
+        CHECK(emulator.counters.data_bytes == 512u);
+        CHECK(ssd1306.get_suppressed_commands() - suppressed == 8u);
+
+        /* Contrast is only sent when it changes. */
+        emulator.reset_counters();
+        ssd1306.set_contrast(0x10u);
+        ssd1306.set_contrast(0x10u);
+        CHECK(emulator.counters.command_bytes == 2u);
+        CHECK(emulator.state.contrast == 0x10u);
+    }
+
+    /* Test that only dirty spans are written. */
+    SUBCASE("Dirty spans")
+    {
+        ssd1306.get_framebuffer()[2u * 128u + 10u] = 0xFFu;
+        ssd1306.get_framebuffer()[2u * 128u + 13u] = 0x81u;
+        ssd1306.mark_dirty(10u, 2u, 13u, 2u);
+
+        emulator.reset_counters();
+        ssd1306.flush();
+
+        CHECK(emulator.counters.data_bytes == 4u);
+        CHECK(emulator.get_gddram()[2u * 128u + 10u] == 0xFFu);
+        CHECK(emulator.get_gddram()[2u * 128u + 13u] == 0x81u);
+        CHECK(!ssd1306.is_dirty());
+    }
+
+    /* Test that a region only writes the bytes of its pages and columns. */
+    SUBCASE("Region")
+    {
+        uint8_t icon[16 * 16];
+
+        random_pixels<ssd1306_128x32_t>(pixels, 6u);
+        ssd1306.display(pixels);
+
+        for (size_t i = 0; i < sizeof(icon); i++)
+        {
+            icon[i] = (i * 7u / 3u) & 1u;
+        }
+
+        /* Page-aligned: two pages of 16 columns. */
+        emulator.reset_counters();
+        ssd1306.display_region(20u, 8u, 16u, 16u, icon);
+        CHECK(emulator.counters.data_bytes == 32u);
+
+        /* Not page-aligned: three pages, the rows around the icon are kept. */
+        emulator.reset_counters();
+        ssd1306.display_region(100u, 4u, 16u, 16u, icon);
+        CHECK(emulator.counters.data_bytes == 48u);
+
+        for (size_t y = 0; y < 16u; y++)
+        {
+            for (size_t x = 0; x < 16u; x++)
+            {
+                pixels[8u + y][20u + x] = icon[y * 16u + x];
+                pixels[4u + y][100u + x] = icon[y * 16u + x];
+            }
+        }
+
+        CHECK(shows<ssd1306_128x32_t>(emulator, pixels));
+    }
+
+    SUBCASE("Saving images")
+    {
+        char file_name[] = "/tmp/ssd1306_image_XXXXXX";
+        uint8_t magic[2] = {};
+
+        close(mkstemp(file_name));
+        emulator.save_pbm(file_name);
+
+        FILE* file = fopen(file_name, "rb");
+
+        REQUIRE(file != nullptr);
+        CHECK(fread(magic, 1u, 2u, file) == 2u);
+        fclose(file);
+        remove(file_name);
+        CHECK(memcmp(magic, "P4", 2u) == 0);
+
+        /* Files that cannot be created are reported, also without assertions. */
+        CHECK_THROWS_AS(emulator.save_pbm("/nonexistent/image.pbm"), ssd1306_emulator_exception);
+        CHECK_THROWS_AS(emulator.save_png("/nonexistent/image.png"), ssd1306_emulator_exception);
+    }
+}
+
+/**
+ * @brief Emulator that also records where the messages it receives are stored.
+ */
+class message_recorder_t : public ssd1306_emulator_t
+{
+public:
+    message_recorder_t() : ssd1306_emulator_t(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL) {}
+
+    bool i2c_sim_write(const uint8_t* data, uint16_t size) override
+    {
+        this->messages.push_back(data);
+        return ssd1306_emulator_t::i2c_sim_write(data, size);
+    }
+
+    std::vector<const uint8_t*> messages;
+};
+
+/**
+ * @brief Tests that frames and dirty spans are sent from the framebuffer itself.
+ */
+TEST_CASE("Test ssd1306_t zero-copy writes")
+{
+    i2c_sim_bus_t i2c_bus;
+    message_recorder_t emulator;
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    uint8_t pixels[32][128];
+    uint8_t framebuffer[ssd1306_128x32_t::FRAMEBUFFER_SIZE];
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+    random_pixels<ssd1306_128x32_t>(pixels, 9u);
+
+    /* A frame is sent in place: each message starts right in front of its part of the framebuffer. */
+    emulator.messages.clear();
+    ssd1306.display(pixels);
+    REQUIRE(emulator.messages.size() == 4u);
+    CHECK(emulator.messages[1] == ssd1306.get_framebuffer() + 127u);
+    CHECK(shows<ssd1306_128x32_t>(emulator, pixels));
+
+    /* A dirty span borrows the byte in front of it, which is restored. */
+    memcpy(framebuffer, ssd1306.get_framebuffer(), sizeof(framebuffer));
+    ssd1306.get_framebuffer()[128u + 40u] ^= 0xFFu;
+    framebuffer[128u + 40u] ^= 0xFFu;
+    ssd1306.mark_dirty(40u, 1u, 40u, 1u);
+
+    emulator.messages.clear();
+    ssd1306.flush();
+    CHECK(emulator.messages.back() == ssd1306.get_framebuffer() + 128u + 39u);
+    CHECK(memcmp(framebuffer, ssd1306.get_framebuffer(), sizeof(framebuffer)) == 0);
+    CHECK(memcmp(framebuffer, emulator.get_gddram(), sizeof(framebuffer)) == 0);
+
+    /* Spans of the framebuffer written by others, e.g. a display group or the animation player, are sent in place
+       too, also the first byte of the framebuffer. Other memory is copied. */
+    emulator.messages.clear();
+    ssd1306.write_span(2u, 10u, 19u, ssd1306.get_framebuffer() + 256u + 10u);
+    CHECK(emulator.messages.back() == ssd1306.get_framebuffer() + 256u + 9u);
+
+    ssd1306.write_span(0u, 0u, 3u, ssd1306.get_framebuffer());
+    CHECK(emulator.messages.back() == ssd1306.get_framebuffer() - 1);
+
+    ssd1306.write_span(0u, 0u, 3u, framebuffer);
+    CHECK(memcmp(framebuffer, ssd1306.get_framebuffer(), sizeof(framebuffer)) == 0);
+    CHECK(memcmp(framebuffer, emulator.get_gddram(), sizeof(framebuffer)) == 0);
+}
+
+/**
+ * @brief Tests the panel geometries.
+ */
+TEST_CASE("Test ssd1306_t geometries")
+{
+    i2c_sim_bus_t i2c_bus;
+
+    SUBCASE("128x64")
+    {
+        ssd1306_emulator_t emulator(128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE);
+        ssd1306_128x64_t ssd1306(i2c_bus);
+        uint8_t pixels[64][128];
+
+        i2c_bus.attach(ADDRESS, emulator);
+        ssd1306.initialise();
+
+        /* 0x12: alternative COM pins without the left/right remap. */
+        CHECK(emulator.state.multiplex_ratio == 64u);
+        CHECK(emulator.state.com_pins_alternative);
+        CHECK(!emulator.state.com_left_right_remap);
+
+        random_pixels<ssd1306_128x64_t>(pixels, 3u);
+        ssd1306.display(pixels);
+        CHECK(shows<ssd1306_128x64_t>(emulator, pixels));
+    }
+
+    SUBCASE("96x16")
+    {
+        ssd1306_emulator_t emulator(96u, 16u, COM_PINS_HARDWARE_SEQUENTIAL);
+        ssd1306_96x16_t ssd1306(i2c_bus);
+        uint8_t pixels[16][96];
+
+        i2c_bus.attach(ADDRESS, emulator);
+        ssd1306.initialise();
+        random_pixels<ssd1306_96x16_t>(pixels, 4u);
+        ssd1306.display(pixels);
+        CHECK(shows<ssd1306_96x16_t>(emulator, pixels));
+    }
+}
+
+/**
+ * @brief Tests hardware flips and software rotation.
+ */
+TEST_CASE("Test ssd1306_t orientation")
+{
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE);
+    ssd1306_128x64_t ssd1306(i2c_bus);
+    static uint8_t pixels[64][128];
+    static uint8_t rotated[128][64];
+    static uint8_t expected[64][128];
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+    random_pixels<ssd1306_128x64_t>(pixels, 7u);
+
+    SUBCASE("180 degrees")
+    {
+        ssd1306.set_orientation(ssd1306_128x64_t::ORIENTATION_180);
+        ssd1306.display(pixels);
+
+        for (size_t y = 0; y < 64u; y++)
+        {
+            for (size_t x = 0; x < 128u; x++)
+            {
+                expected[63u - y][127u - x] = pixels[y][x];
+            }
+        }
+
+        CHECK(emulator.state.segment_remap);
+        CHECK(emulator.state.com_scan_remapped);
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+    }
+
+    SUBCASE("Mirrored")
+    {
+        ssd1306.set_orientation(ssd1306_128x64_t::ORIENTATION_0, true);
+        ssd1306.display(pixels);
+
+        for (size_t y = 0; y < 64u; y++)
+        {
+            for (size_t x = 0; x < 128u; x++)
+            {
+                expected[y][127u - x] = pixels[y][x];
+            }
+        }
+
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+    }
+
+    SUBCASE("Remap after data was written")
+    {
+        ssd1306.display(pixels);
+
+        const std::vector<uint8_t> before = emulator.render();
+
+        /* The segment remap only applies to data written after it, so the panel keeps showing the same image. */
+        ssd1306.set_segmet_re_map(ssd1306_128x64_t::RE_MAP_MODE_127);
+        CHECK(emulator.state.segment_remap);
+        CHECK(emulator.render() == before);
+
+        /* Writing the frame again mirrors it. */
+        ssd1306.display_framebuffer();
+
+        for (size_t y = 0; y < 64u; y++)
+        {
+            for (size_t x = 0; x < 128u; x++)
+            {
+                expected[y][127u - x] = pixels[y][x];
+            }
+        }
+
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+    }
+
+    SUBCASE("90 and 270 degrees")
+    {
+        for (size_t y = 0; y < 128u; y++)
+        {
+            for (size_t x = 0; x < 64u; x++)
+            {
+                rotated[y][x] = pixels[x][y] ^ (y & 1u);
+            }
+        }
+
+        /* Clockwise: the top left of the canvas is in the top right of the panel. */
+        ssd1306.set_orientation(ssd1306_128x64_t::ORIENTATION_90);
+        CHECK(ssd1306.get_canvas_width() == 64u);
+        CHECK(ssd1306.get_canvas_height() == 128u);
+        ssd1306.display_region(0u, 0u, 64u, 128u, &rotated[0][0]);
+
+        for (size_t y = 0; y < 128u; y++)
+        {
+            for (size_t x = 0; x < 64u; x++)
+            {
+                expected[x][127u - y] = rotated[y][x];
+            }
+        }
+
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+
+        /* Drawing in the canvas: toggle the pixel in the top left corner. */
+        ssd1306.get_canvas()[0] ^= 1u;
+        expected[0][127] ^= 1u;
+        emulator.reset_counters();
+        ssd1306.present();
+        CHECK(emulator.counters.data_bytes == 8u);
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+
+        ssd1306.set_orientation(ssd1306_128x64_t::ORIENTATION_270);
+        ssd1306.display_region(0u, 0u, 64u, 128u, &rotated[0][0]);
+
+        for (size_t y = 0; y < 128u; y++)
+        {
+            for (size_t x = 0; x < 64u; x++)
+            {
+                expected[63u - x][y] = rotated[y][x];
+            }
+        }
+
+        CHECK(shows<ssd1306_128x64_t>(emulator, expected));
+    }
+
+    SUBCASE("Narrow panel")
+    {
+        ssd1306_emulator_t narrow_emulator(96u, 16u, COM_PINS_HARDWARE_SEQUENTIAL);
+        ssd1306_96x16_t narrow(i2c_bus, 1u);
+        uint8_t narrow_pixels[16][96];
+        uint8_t narrow_expected[16][96];
+
+        i2c_bus.attach(ADDRESS | 1u, narrow_emulator);
+        narrow.set_orientation(ssd1306_96x16_t::ORIENTATION_180);
+        narrow.initialise();
+        random_pixels<ssd1306_96x16_t>(narrow_pixels, 8u);
+        narrow.display(narrow_pixels);
+
+        for (size_t y = 0; y < 16u; y++)
+        {
+            for (size_t x = 0; x < 96u; x++)
+            {
+                narrow_expected[15u - y][95u - x] = narrow_pixels[y][x];
+            }
+        }
+
+        CHECK(shows<ssd1306_96x16_t>(narrow_emulator, narrow_expected));
+    }
+}
+
+/**
+ * @brief Tests the controller-side effects. Time is passed in explicitly, so nothing sleeps.
+ */
+TEST_CASE("Test ssd1306_effects_t")
+{
+    using clock = ssd1306_effects_t<ssd1306_128x32_t>::clock;
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    const clock::time_point start;
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    ssd1306_effects_t<ssd1306_128x32_t> effects(ssd1306);
+
+    SUBCASE("Ticker")
+    {
+        effects.start_ticker(1u, 2u);
+        CHECK(emulator.state.scroll_active);
+
+        emulator.reset_counters();
+        effects.stop_ticker();
+        CHECK(!emulator.state.scroll_active);
+        CHECK(emulator.counters.data_bytes == 512u);
+    }
+
+    SUBCASE("Fade")
+    {
+        clock::time_point now = start;
+
+        emulator.reset_counters();
+        effects.fade(0x00u, std::chrono::milliseconds(200), now);
+
+        while (effects.is_active())
+        {
+            now = effects.update(now);
+            CHECK(now - start <= std::chrono::milliseconds(200));
+            effects.update(now);
+        }
+
+        CHECK(emulator.state.contrast == 0x00u);
+        /* At most one step per FADE_STEP_INTERVAL, two command bytes each, and no data. */
+        CHECK(effects.get_steps() <= 11u);
+        CHECK(emulator.counters.command_bytes == 2u * effects.get_steps());
+        CHECK(emulator.counters.data_bytes == 0u);
+    }
+
+    SUBCASE("Blink")
+    {
+        clock::time_point now = start;
+        uint32_t inversions = 0u;
+        bool inverse = false;
+
+        effects.blink(3u, std::chrono::milliseconds(100), now);
+
+        while (true)
+        {
+            if (emulator.state.inverse != inverse)
+            {
+                inverse = emulator.state.inverse;
+                inversions++;
+            }
+
+            if (!effects.is_active())
+            {
+                break;
+            }
+
+            /* Jump to the time of the next command. */
+            const clock::time_point next = effects.update(now);
+
+            if (next != clock::time_point::max())
+            {
+                now = next;
+                effects.update(now);
+            }
+        }
+
+        CHECK(inversions == 6u);
+        CHECK(!emulator.state.inverse);
+        CHECK(now - start == std::chrono::milliseconds(250));
+    }
+}
+
+/**
+ * @brief Tests the compositor: blending, stacking and that only visible changes reach the bus.
+ */
+TEST_CASE("Test ssd1306_compositor_t")
+{
+    using compositor_t = ssd1306_compositor_t<ssd1306_128x32_t>;
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    compositor_t compositor(ssd1306);
+    const uint8_t background = compositor.add_layer(0u, 0u, 128u, 4u);
+    const uint8_t clock = compositor.add_layer(100u, 0u, 20u, 1u, 1u);
+    const uint8_t popup = compositor.add_layer(90u, 0u, 20u, 2u, 2u);
+    const uint8_t overlay = compositor.add_layer(0u, 2u, 8u, 1u, 3u, compositor_t::BLEND_TRANSPARENT);
+    const uint8_t cursor = compositor.add_layer(8u, 2u, 8u, 1u, 3u, compositor_t::BLEND_MASKED);
+    const uint8_t* gddram = emulator.get_gddram();
+
+    memset(compositor.get_pixels(background), 0x0Fu, 128u * 4u);
+    memset(compositor.get_pixels(clock), 0xAAu, 20u);
+    memset(compositor.get_pixels(popup), 0xFFu, 40u);
+    memset(compositor.get_pixels(overlay), 0xC0u, 8u);
+    memset(compositor.get_pixels(cursor), 0x30u, 8u);
+    memset(compositor.get_mask(cursor), 0xF0u, 8u);
+    compositor.compose();
+
+    /* Popup over clock over background, and the two blend modes. */
+    CHECK(gddram[0u] == 0x0Fu);
+    CHECK(gddram[95u] == 0xFFu);
+    CHECK(gddram[110u] == 0xAAu);
+    CHECK(gddram[120u] == 0x0Fu);
+    CHECK(gddram[2u * 128u + 0u] == 0xCFu);
+    CHECK(gddram[2u * 128u + 8u] == 0x3Fu);
+
+    SUBCASE("Hidden update")
+    {
+        const uint32_t columns_changed = compositor.get_statistics().columns_changed;
+
+        /* Only the part of the clock that is under the popup changes. */
+        memset(compositor.get_pixels(clock), 0x55u, 10u);
+        compositor.damage(clock, 0u, 0u, 9u, 0u);
+        emulator.reset_counters();
+        compositor.compose();
+
+        CHECK(emulator.counters.data_bytes == 0u);
+        CHECK(compositor.get_statistics().columns_changed == columns_changed);
+    }
+
+    SUBCASE("Partial update")
+    {
+        memset(compositor.get_pixels(clock), 0x55u, 20u);
+        compositor.damage(clock);
+        emulator.reset_counters();
+        compositor.compose();
+
+        CHECK(emulator.counters.data_bytes == 10u);
+        CHECK(gddram[105u] == 0xFFu);
+        CHECK(gddram[110u] == 0x55u);
+    }
+
+    SUBCASE("Move, hide and restack")
+    {
+        compositor.move_layer(popup, 0u, 0u);
+        compositor.compose();
+        CHECK(gddram[0u] == 0xFFu);
+        CHECK(gddram[95u] == 0x0Fu);
+        CHECK(gddram[105u] == 0xAAu);
+
+        compositor.set_z(clock, 3u);
+        compositor.set_visible(background, false);
+        compositor.move_layer(clock, 10u, 0u);
+        compositor.compose();
+        CHECK(gddram[15u] == 0xAAu);
+        CHECK(gddram[105u] == 0x00u);
+        CHECK(gddram[3u * 128u] == 0x00u);
+
+        /* Recomposing without damage does nothing. */
+        const ssd1306_compositor_statistics_t statistics = compositor.get_statistics();
+
+        emulator.reset_counters();
+        compositor.compose();
+        CHECK(emulator.counters.bytes == 0u);
+        CHECK(compositor.get_statistics().compositions == statistics.compositions);
+    }
+}
+
+/**
+ * @brief Tests sprites at every shift, clipping, dirty marking and collisions.
+ */
+TEST_CASE("Test ssd1306_sprite_t")
+{
+    /* A plus with a hole in the middle, so the mask matters. */
+    static const uint8_t plus[3u * 3u] = { 0u, 1u, 0u,
+                                           1u, 0u, 1u,
+                                           0u, 1u, 0u };
+    static const uint8_t block[3u * 3u] = { 1u, 1u, 1u,
+                                            1u, 1u, 1u,
+                                            1u, 1u, 1u };
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    const ssd1306_sprite_t sprite(3u, 3u, plus, block);
+    const ssd1306_sprite_t dot(1u, 1u, block);
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    ssd1306_sprite_engine_t<ssd1306_128x32_t> engine(ssd1306);
+
+    for (uint8_t shift = 0u; shift < ssd1306_sprite_t::SHIFTS; shift++)
+    {
+        CHECK(sprite.get_pages(shift) == (shift < 6u ? 1u : 2u));
+    }
+
+    SUBCASE("Draw at every y")
+    {
+        for (int16_t y = 0; y < 16; y++)
+        {
+            ssd1306.clear_screen();
+
+            /* The mask of the sprite clears the pixel that was on in its middle. */
+            ssd1306.get_framebuffer()[(y + 1) / 8 * 128 + 11] = 1u << ((y + 1) % 8);
+            ssd1306.mark_dirty();
+            engine.draw(sprite, 10, y);
+            ssd1306.flush();
+
+            const std::vector<uint8_t> image = emulator.render();
+            uint32_t lit = 0u;
+
+            for (size_t i = 0; i < image.size(); i++)
+            {
+                lit += image[i];
+            }
+
+            CHECK(lit == 4u);
+            CHECK(image[y * 128u + 11u] == 1u);
+            CHECK(image[(y + 1u) * 128u + 10u] == 1u);
+            CHECK(image[(y + 1u) * 128u + 12u] == 1u);
+            CHECK(image[(y + 2u) * 128u + 11u] == 1u);
+        }
+    }
+
+    SUBCASE("Dirty marking and erase")
+    {
+        emulator.reset_counters();
+        engine.draw(sprite, 20, 6);
+        ssd1306.flush();
+        CHECK(emulator.counters.data_bytes == 6u);
+
+        emulator.reset_counters();
+        engine.erase(sprite, 20, 6);
+        ssd1306.flush();
+        CHECK(emulator.counters.data_bytes == 6u);
+
+        for (size_t i = 0; i < ssd1306_128x32_t::FRAMEBUFFER_SIZE; i++)
+        {
+            REQUIRE(ssd1306.get_framebuffer()[i] == 0u);
+        }
+    }
+
+    SUBCASE("Clipping")
+    {
+        engine.draw(sprite, -1, -1);
+        engine.draw(sprite, 126, 30);
+        engine.draw(sprite, -5, 40);
+        ssd1306.flush();
+
+        const std::vector<uint8_t> image = emulator.render();
+
+        CHECK(image[0u] == 0u);
+        CHECK(image[1u] == 1u);
+        CHECK(image[1u * 128u + 0u] == 1u);
+        CHECK(image[30u * 128u + 127u] == 1u);
+        CHECK(image[31u * 128u + 126u] == 1u);
+        CHECK(image[31u * 128u + 127u] == 0u);
+    }
+
+    SUBCASE("Collisions")
+    {
+        CHECK(sprite.collides(10, 10, sprite, 12, 12));
+        CHECK(!sprite.collides(10, 10, sprite, 13, 10));
+        CHECK(!sprite.collides(10, 5, sprite, 10, 8));
+        CHECK(sprite.collides(10, -1, dot, 12, 1));
+        CHECK(!dot.collides(0, 7, dot, 0, 8));
+
+        engine.draw(dot, 40, 9);
+        CHECK(engine.overlaps(sprite, 39, 7));
+        CHECK(!engine.overlaps(sprite, 39, 10));
+        CHECK(!engine.overlaps(sprite, 41, 7));
+        CHECK(!engine.overlaps(sprite, 41, 6));
+    }
+}
+
+/**
+ * @brief Tests the display server with two clients in the same process.
+ */
+TEST_CASE("Test ssd1306_server_t")
+{
+    const std::string name = "/ssd1306_test_" + std::to_string(getpid());
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    ssd1306_server_t<ssd1306_128x32_t> server(ssd1306, name);
+    ssd1306_client_t background(name, 0u);
+    ssd1306_client_t popup(name, 1u);
+
+    CHECK(background.get_width() == 128u);
+    CHECK(background.get_pages() == 4u);
+
+    /* Only the user of the server can connect, and a second server does not take over the name. */
+    struct stat status;
+
+    REQUIRE(stat(("/dev/shm" + name).c_str(), &status) == 0);
+    CHECK((status.st_mode & 0777u) == 0600u);
+    CHECK_THROWS_AS(ssd1306_server_t<ssd1306_128x32_t>(ssd1306, name), ssd1306_server_exception);
+    CHECK(stat(("/dev/shm" + name).c_str(), &status) == 0);
+
+    /* The background covers the screen with vertical stripes. */
+    memset(background.get_mask(), 0xFF, 512u);
+    for (size_t i = 0; i < 512u; i++)
+    {
+        background.get_pixels()[i] = i % 2u ? 0xFFu : 0x00u;
+    }
+    background.damage();
+
+    CHECK(server.wait(std::chrono::milliseconds(0)));
+    CHECK(server.process());
+    CHECK(emulator.get_gddram()[129u] == 0xFFu);
+
+    /* The popup covers the upper half of page 1 in columns 10 to 19 and is all off there. */
+    for (size_t column = 10u; column < 20u; column++)
+    {
+        popup.get_mask()[128u + column] = 0x0Fu;
+    }
+
+    emulator.reset_counters();
+    popup.damage(10u, 1u, 19u, 1u);
+    server.process();
+    CHECK(emulator.counters.data_bytes == 10u);
+    CHECK(emulator.get_gddram()[128u + 11u] == 0xF0u);
+    CHECK(emulator.get_gddram()[128u + 21u] == 0xFFu);
+
+    /* Hiding the popup shows the background again. */
+    popup.set_visible(false);
+    server.process();
+    CHECK(emulator.get_gddram()[128u + 11u] == 0xFFu);
+
+    /* No damage, nothing to do. */
+    CHECK(!server.process());
+    CHECK(!server.wait(std::chrono::milliseconds(1)));
+}
+
+/**
+ * @brief Tests ssd1306_t on a transport other than I2C, and the multi-transfer writes of spi_device_t.
+ * The D/C and RST pins are on the simulated GPIO chip.
+ */
+TEST_CASE("Test ssd1306_t over SPI")
+{
+    static constexpr uint8_t DC_PIN = 24u;
+    static constexpr uint8_t RESET_PIN = 25u;
+
+    gpio_sim_chip_t chip;
+    gpio_pin_t dc_pin(DC_PIN);
+    gpio_pin_t reset_pin(RESET_PIN);
+    spi_mock_device_t spi_device;
+    ssd1306_emulator_t emulator(128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE);
+    ssd1306_spi_transport_t transport(spi_device, dc_pin, reset_pin);
+    ssd1306_128x64_t ssd1306(transport);
+    uint8_t pixels[64][128];
+    /* Level of the D/C pin at each transfer. */
+    std::vector<uint8_t> dc_levels;
+
+    gpio_set_sim_chip(&chip);
+    gpio_set_default_backend(GPIO_BACKEND_SIMULATED);
+
+    spi_device.on_transfer = [&](const uint8_t* data, uint32_t size) {
+        dc_levels.push_back(chip.read(DC_PIN));
+        emulator.spi_sim_write(data, size, dc_levels.back() == GPIO_STATE_HIGH);
+    };
+
+    ssd1306.initialise();
+
+    /* RES is pulled low for at least 3 us and then released. */
+    const std::vector<gpio_sim_transition_t> reset = chip.get_transitions(RESET_PIN);
+
+    REQUIRE(reset.size() == 3u);
+    CHECK(reset[0].value == GPIO_STATE_HIGH);
+    CHECK(reset[1].value == GPIO_STATE_LOW);
+    CHECK(reset[2].value == GPIO_STATE_HIGH);
+    CHECK(reset[2].timestamp - reset[1].timestamp >= std::chrono::microseconds(3));
+
+    /* After the reset, initialisation sends commands, clears GDDRAM with one data transfer and enables the display. */
+    const size_t clear = std::find(dc_levels.begin(), dc_levels.end(), GPIO_STATE_HIGH) - dc_levels.begin();
+
+    REQUIRE(spi_device.transfers.size() == dc_levels.size());
+    REQUIRE(clear < dc_levels.size());
+    CHECK(dc_levels.front() == GPIO_STATE_LOW);
+    CHECK(dc_levels.back() == GPIO_STATE_LOW);
+    CHECK(std::count(dc_levels.begin(), dc_levels.end(), GPIO_STATE_HIGH) == 1);
+    CHECK(spi_device.transfers[clear].size() == 1024u);
+    REQUIRE(chip.get_transitions(DC_PIN).size() == 2u);
+    CHECK(chip.get_transitions(DC_PIN)[0].timestamp > reset[2].timestamp);
+
+    SUBCASE("Full frame in one ioctl")
+    {
+        random_pixels<ssd1306_128x64_t>(pixels, 5u);
+        ssd1306.display(pixels);
+        CHECK(shows<ssd1306_128x64_t>(emulator, pixels));
+
+        /* The frame is data, the address commands in front of it are commands. */
+        CHECK(dc_levels.back() == GPIO_STATE_HIGH);
+        CHECK(std::count(dc_levels.begin(), dc_levels.end(), GPIO_STATE_LOW) > 0);
+
+        /* D/C only changes when a data write follows a command write or the other way around. */
+        uint32_t switches = 0u;
+
+        for (size_t i = 1; i < dc_levels.size(); i++)
+        {
+            switches += dc_levels[i] != dc_levels[i - 1u];
+        }
+
+        CHECK(chip.get_transitions(DC_PIN).size() == switches);
+
+        spi_device.ioctls = 0u;
+        spi_device.transfers.clear();
+        ssd1306.display_framebuffer();
+        CHECK(spi_device.ioctls == 1u);
+        CHECK(spi_device.transfers.back().size() == 1024u);
+    }
+
+    SUBCASE("Writes larger than the spidev buffer")
+    {
+        std::vector<uint8_t> data(2u * spi_device_t::MAX_TRANSFER_SIZE + 100u);
+
+        spi_device.ioctls = 0u;
+        spi_device.transfers.clear();
+        spi_device.spi_write(data.data(), data.size());
+        CHECK(spi_device.ioctls == 1u);
+        REQUIRE(spi_device.transfers.size() == 3u);
+        CHECK(spi_device.transfers[0].size() == spi_device_t::MAX_TRANSFER_SIZE);
+        CHECK(spi_device.transfers[2].size() == 100u);
+    }
+
+    gpio_set_default_backend(GPIO_BACKEND_CHARDEV);
+    gpio_set_sim_chip(nullptr);
+}
+
+/**
+ * @brief Tests ssd1306_group_t with two panels on one bus.
+ */
+TEST_CASE("Test ssd1306_group_t")
+{
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator_0(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_emulator_t emulator_1(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306_0(i2c_bus, 0u);
+    ssd1306_128x32_t ssd1306_1(i2c_bus, 1u);
+    ssd1306_group_t<ssd1306_128x32_t> group;
+
+    i2c_bus.attach(ADDRESS, emulator_0);
+    i2c_bus.attach(ADDRESS | 1u, emulator_1);
+    group.add_panel(ssd1306_0);
+    group.add_panel(ssd1306_1);
+    group.initialise();
+
+    SUBCASE("Canvas")
+    {
+        group.add_to_canvas(0u);
+        group.add_to_canvas(1u);
+        CHECK(group.get_canvas_width() == 256u);
+
+        group.set_canvas_pixel(5u, 3u, true);
+        group.set_canvas_pixel(200u, 31u, true);
+        group.flush();
+
+        CHECK(emulator_0.render()[3u * 128u + 5u] == 1u);
+        CHECK(emulator_1.render()[31u * 128u + 72u] == 1u);
+
+        const ssd1306_group_statistics_t statistics = group.get_statistics();
+        CHECK(statistics.panels[0].frames == 1u);
+        CHECK(statistics.panels[1].frames == 1u);
+        CHECK(statistics.bytes == 2u);
+    }
+
+    SUBCASE("Mirror")
+    {
+        group.mirror(0u, 1u);
+        group.flush();
+        memset(ssd1306_0.get_framebuffer(), 0xA5u, 128u);
+        ssd1306_0.mark_dirty(0u, 0u, 127u, 0u);
+        group.flush();
+
+        CHECK(emulator_0.render() == emulator_1.render());
+        CHECK(emulator_1.get_gddram()[17] == 0xA5u);
+    }
+
+    SUBCASE("Latency")
+    {
+        /* The frame waits from the moment it is marked dirty, not from the first flush step. */
+        ssd1306_0.mark_dirty(0u, 0u, 0u, 0u);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ssd1306_0.mark_dirty(1u, 0u, 1u, 0u);
+        group.flush();
+
+        const ssd1306_group_statistics_t statistics = group.get_statistics();
+        CHECK(statistics.panels[0].frames == 1u);
+        CHECK(statistics.panels[0].max_latency_ms >= 20.0);
+    }
+}
+
+/**
+ * @brief Tests writing and playing an animation file.
+ */
+TEST_CASE("Test ssd1306_animation_t")
+{
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    ssd1306_animation_writer_t writer(128u, 32u, 10u);
+    ssd1306_animation_t<ssd1306_128x32_t> animation(ssd1306);
+    uint8_t frames[3][512] = {};
+    char file_name[] = "/tmp/ssd1306_animation_XXXXXX";
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    /* A small moving block. */
+    for (size_t frame = 0; frame < 3u; frame++)
+    {
+        memset(&frames[frame][128u + 20u * frame], 0xFFu, 8u);
+        writer.add_frame(frames[frame]);
+    }
+
+    close(mkstemp(file_name));
+    writer.save(file_name);
+    animation.open(file_name);
+
+    CHECK(animation.get_frame_count() == 3u);
+    CHECK(animation.get_frame_rate() == 10u);
+
+    for (size_t frame = 0; frame < 3u; frame++)
+    {
+        CHECK(animation.next_frame());
+        CHECK(memcmp(emulator.get_gddram(), frames[frame], 512u) == 0);
+    }
+
+    /* Without looping the animation ends. */
+    CHECK(!animation.next_frame());
+
+    /* The loop frame only writes the changed columns. */
+    emulator.reset_counters();
+    CHECK(animation.next_frame(true));
+    CHECK(memcmp(emulator.get_gddram(), frames[0], 512u) == 0);
+    CHECK(emulator.counters.data_bytes == 16u);
+
+    animation.close();
+
+    /* An animation without frames shows nothing, also when looping. */
+    ssd1306_animation_writer_t empty_writer(128u, 32u, 10u);
+
+    empty_writer.save(file_name);
+    animation.open(file_name);
+    CHECK(animation.get_frame_count() == 0u);
+
+    emulator.reset_counters();
+    CHECK(!animation.next_frame());
+    CHECK(!animation.next_frame(true));
+    CHECK(emulator.counters.data_bytes == 0u);
+    CHECK(memcmp(emulator.get_gddram(), frames[0], 512u) == 0);
+
+    animation.close();
+    remove(file_name);
+}
+
+/**
+ * @brief Get a pixel of a page-major framebuffer.
+ */
+static uint8_t framebuffer_pixel(const uint8_t* framebuffer, size_t width, size_t x, size_t y)
+{
+    return (framebuffer[(y / 8u) * width + x] >> (y % 8u)) & 1u;
+}
+
+/**
+ * @brief Tests the dithering modes on flat fields and gradients.
+ */
+TEST_CASE("Test ssd1306_dither_t")
+{
+    static constexpr size_t WIDTH = 128u;
+    static constexpr size_t HEIGHT = 64u;
+
+    ssd1306_dither_t dither(WIDTH, HEIGHT);
+    std::vector<uint8_t> image(WIDTH * HEIGHT);
+    uint8_t framebuffer[WIDTH * HEIGHT / 8u];
+
+    SUBCASE("Threshold")
+    {
+        /* 50% gray is the threshold: 127 is off, 128 is on. */
+        for (size_t y = 0; y < HEIGHT; y++)
+        {
+            for (size_t x = 0; x < WIDTH; x++)
+            {
+                image[y * WIDTH + x] = x % 2u == 0u ? 127u : 128u;
+            }
+        }
+
+        memset(framebuffer, 0xAAu, sizeof(framebuffer));
+        dither.convert(ssd1306_dither_t::DITHER_THRESHOLD, image.data(), WIDTH, HEIGHT, WIDTH, framebuffer);
+
+        for (size_t x = 0; x < WIDTH; x++)
+        {
+            CHECK(framebuffer[x] == (x % 2u == 0u ? 0x00u : 0xFFu));
+        }
+
+        /* An image of 4 rows keeps the lower 4 rows of the page. */
+        memset(framebuffer, 0xAAu, sizeof(framebuffer));
+        dither.convert(ssd1306_dither_t::DITHER_THRESHOLD, image.data(), WIDTH, 4u, WIDTH, framebuffer);
+        CHECK(framebuffer[0] == 0xA0u);
+        CHECK(framebuffer[1] == 0xAFu);
+        CHECK(framebuffer[WIDTH] == 0xAAu);
+    }
+
+    SUBCASE("Ordered")
+    {
+        /* A flat field gives the same 8x8 tile everywhere, with one pixel on per Bayer threshold below the value.
+           100 columns use both the 16-column path and the remaining columns. */
+        for (const uint8_t value : { 0u, 1u, 64u, 128u, 200u, 255u })
+        {
+            uint32_t on = 0u;
+
+            std::fill(image.begin(), image.end(), value);
+            memset(framebuffer, 0u, sizeof(framebuffer));
+            dither.convert(ssd1306_dither_t::DITHER_ORDERED, image.data(), 100u, HEIGHT, WIDTH, framebuffer);
+
+            for (size_t y = 0; y < 8u; y++)
+            {
+                for (size_t x = 0; x < 8u; x++)
+                {
+                    on += framebuffer_pixel(framebuffer, WIDTH, x, y);
+                }
+            }
+
+            /* The thresholds are 4 * index + 2 for the indices 0 to 63. */
+            CHECK(on == std::min<uint32_t>(64u, (value + 1u) / 4u));
+
+            bool periodic = true;
+
+            for (size_t y = 0; y < HEIGHT; y++)
+            {
+                for (size_t x = 0; x < 100u; x++)
+                {
+                    periodic &= framebuffer_pixel(framebuffer, WIDTH, x, y) == framebuffer_pixel(framebuffer, WIDTH, x % 8u, y % 8u);
+                }
+            }
+
+            CHECK(periodic);
+        }
+
+        /* 50% gray is a checkerboard. */
+        std::fill(image.begin(), image.end(), 128u);
+        dither.convert(ssd1306_dither_t::DITHER_ORDERED, image.data(), WIDTH, HEIGHT, WIDTH, framebuffer);
+
+        for (size_t x = 0; x < WIDTH; x++)
+        {
+            CHECK(framebuffer[x] == (x % 2u == 0u ? 0x55u : 0xAAu));
+        }
+    }
+
+    SUBCASE("Error diffusion")
+    {
+        /* A horizontal gradient from black to white. */
+        for (size_t y = 0; y < HEIGHT; y++)
+        {
+            for (size_t x = 0; x < WIDTH; x++)
+            {
+                image[y * WIDTH + x] = x * 2u;
+            }
+        }
+
+        dither.convert(ssd1306_dither_t::DITHER_FLOYD_STEINBERG, image.data(), WIDTH, HEIGHT, WIDTH, framebuffer);
+
+        /* Floyd-Steinberg keeps the error, so each band of 16 columns has the mean density of its gray levels. */
+        for (size_t band = 0; band < WIDTH; band += 16u)
+        {
+            uint32_t on = 0u;
+            uint32_t sum = 0u;
+
+            for (size_t y = 0; y < HEIGHT; y++)
+            {
+                for (size_t x = band; x < band + 16u; x++)
+                {
+                    on += framebuffer_pixel(framebuffer, WIDTH, x, y);
+                    sum += image[y * WIDTH + x];
+                }
+            }
+
+            CHECK((double)on / (16u * HEIGHT) == doctest::Approx(sum / 255.0 / (16u * HEIGHT)).epsilon(0.02));
+        }
+    }
+}
+
+/**
+ * @brief Tests that the bitplanes of a grayscale frame show each pixel for as many subframes as its level.
+ */
+TEST_CASE("Test ssd1306_grayscale_t")
+{
+    i2c_sim_bus_t i2c_bus;
+    ssd1306_emulator_t emulator(128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    uint8_t levels[32][128];
+
+    i2c_bus.attach(ADDRESS, emulator);
+    ssd1306.initialise();
+
+    for (uint8_t bits = 2u; bits <= 3u; bits++)
+    {
+        ssd1306_grayscale_t<ssd1306_128x32_t> grayscale(ssd1306, bits);
+        const uint8_t max_level = grayscale.get_subframe_count();
+        std::vector<uint8_t> on_count(128u * 32u, 0u);
+
+        CHECK(max_level == (1u << bits) - 1u);
+
+        /* Every level in every row, at different columns per row. */
+        for (size_t y = 0; y < 32u; y++)
+        {
+            for (size_t x = 0; x < 128u; x++)
+            {
+                levels[y][x] = (x + y) % (max_level + 1u);
+            }
+        }
+
+        grayscale.set_frame(levels);
+
+        for (uint8_t subframe = 0u; subframe < max_level; subframe++)
+        {
+            grayscale.show_subframe();
+
+            const std::vector<uint8_t> pixels = emulator.render();
+
+            for (size_t i = 0; i < pixels.size(); i++)
+            {
+                on_count[i] += pixels[i];
+            }
+        }
+
+        /* A pixel of level n is on in n of the 2^bits - 1 bitplanes. */
+        bool matches = true;
+
+        for (size_t y = 0; y < 32u; y++)
+        {
+            for (size_t x = 0; x < 128u; x++)
+            {
+                matches &= on_count[y * 128u + x] == levels[y][x];
+            }
+        }
+
+        CHECK(matches);
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * @file grayscale_benchmark.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Drives a 128x32 display with temporal grayscale as fast as possible and reports the achieved rates.
+ * @date 18-10-2026
+ */
+
+#include <iostream>
+
+#include "include/ssd1306_grayscale.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Duration of each measurement. */
+static constexpr std::chrono::seconds DURATION(5);
+
+int main()
+{
+    i2c_bus_t i2c_bus(1u);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+    uint8_t levels[ssd1306_128x32_t::SCREEN_HEIGHT][ssd1306_128x32_t::SCREEN_WIDTH];
+
+    ssd1306.initialise();
+
+    for (uint8_t bits = 2u; bits <= 3u; bits++)
+    {
+        ssd1306_grayscale_t<ssd1306_128x32_t> grayscale(ssd1306, bits);
+        const uint8_t max_level = grayscale.get_subframe_count();
+
+        /* Horizontal gradient over all levels: the worst case, every bitplane changes a band of the screen. */
+        for (size_t y = 0; y < ssd1306_128x32_t::SCREEN_HEIGHT; y++)
+        {
+            for (size_t x = 0; x < ssd1306_128x32_t::SCREEN_WIDTH; x++)
+            {
+                levels[y][x] = x * (max_level + 1u) / ssd1306_128x32_t::SCREEN_WIDTH;
+            }
+        }
+
+        grayscale.set_frame(levels);
+
+        const ssd1306_grayscale_statistics_t statistics = grayscale.run(DURATION);
+
+        std::cout << (int)bits << " bits: "
+                  << statistics.subframes_per_second << " bitplanes/s, "
+                  << statistics.cycles_per_second << " frames/s, "
+                  << statistics.bytes / DURATION.count() << " bytes/s, "
+                  << (statistics.flicker_free ? "flicker free" : "visible flicker") << std::endl;
+    }
+
+    return 0;
+}
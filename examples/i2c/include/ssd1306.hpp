@@ -1,23 +1,82 @@
 #pragma once
 
-#include "../../../src/i2c/include/i2c_device.hpp"
+#include <array>
+#include <chrono>
+#include <memory>
+
+#include "ssd1306_transport.hpp"
 
 namespace pi_zero_peripherals
 {
 
-class ssd1306_t : public i2c_device_t
+/* Wiring of the COM pins of a panel, selected with the 0xDA command. */
+enum ssd1306_com_pins_configuration : uint8_t {
+    COM_PINS_HARDWARE_SEQUENTIAL  = 0u,
+    COM_PINS_HARDWARE_ALTERNATIVE = 1u
+};
+
+/**
+ * @brief Driver for an SSD1306 OLED panel.
+ * The panel geometry is known at compile time, so framebuffer sizes, loop bounds and address windows are constants.
+ * Supported geometries are explicitly instantiated in ssd1306.cpp.
+ * The controller is reached through a transport (I2C by default, or SPI), the driver itself only produces commands and data.
+ *
+ * @tparam WIDTH Number of columns of the panel (at most 128).
+ * @tparam HEIGHT Number of rows of the panel (multiple of 8, between 16 and 64).
+ * @tparam COM_PINS COM pins hardware configuration of the panel.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+class ssd1306_t
 {
-private:
-    static constexpr uint8_t SCREEN_WIDTH = 128u;
-    static constexpr uint8_t SCREEN_HEIGHT = 32u;
-    static constexpr uint8_t NUMBER_OF_PAGES = SCREEN_HEIGHT / 8u;
-    static constexpr uint8_t ADDRESS_BASE = 0b0111100u;
+    static_assert(WIDTH > 0u && WIDTH <= 128u, "SSD1306 supports at most 128 columns");
+    static_assert(HEIGHT >= 16u && HEIGHT <= 64u && HEIGHT % 8u == 0u, "SSD1306 height must be a multiple of 8 between 16 and 64");
 public:
+    static constexpr uint8_t SCREEN_WIDTH = WIDTH;
+    static constexpr uint8_t SCREEN_HEIGHT = HEIGHT;
+    static constexpr uint8_t NUMBER_OF_PAGES = SCREEN_HEIGHT / 8u;
+    static constexpr uint16_t FRAMEBUFFER_SIZE = SCREEN_WIDTH * NUMBER_OF_PAGES;
+    static constexpr uint8_t GDDRAM_WIDTH = 128u;
+
     ssd1306_t(i2c_bus_t& bus, uint8_t address_lsb = 0u);
+    ssd1306_t(ssd1306_transport_t& transport);
+
+    /* The framebuffer pointer points into the object itself, and the transport may be owned by it. */
+    ssd1306_t(const ssd1306_t&) = delete;
+    ssd1306_t& operator=(const ssd1306_t&) = delete;
+    ssd1306_t(ssd1306_t&&) = delete;
+    ssd1306_t& operator=(ssd1306_t&&) = delete;
+
     void initialise();
     void display(uint8_t display_data[SCREEN_HEIGHT][SCREEN_WIDTH]);
+    void display_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data);
+    void display_framebuffer();
     void clear_screen();
     uint8_t get_display_status();
+    uint8_t* get_framebuffer();
+
+    /* Rotation of the image, clockwise. */
+    enum orientation : uint8_t {
+        ORIENTATION_0   = 0u,
+        ORIENTATION_90  = 1u,
+        ORIENTATION_180 = 2u,
+        ORIENTATION_270 = 3u
+    };
+
+    void set_orientation(orientation rotation, bool mirror = false);
+    uint8_t* get_canvas();
+    uint8_t get_canvas_width();
+    uint8_t get_canvas_height();
+    void present();
+
+    void mark_dirty(uint8_t column_start = 0u, uint8_t page_start = 0u, uint8_t column_end = SCREEN_WIDTH - 1u, uint8_t page_end = NUMBER_OF_PAGES - 1u);
+    bool is_dirty();
+    std::chrono::steady_clock::time_point get_dirty_since();
+    bool take_dirty_span(uint8_t& page, uint8_t& column_start, uint8_t& column_end);
+    void write_span(uint8_t page, uint8_t column_start, uint8_t column_end, const uint8_t* data);
+    void flush();
+
+    void invalidate_shadow();
+    uint32_t get_suppressed_commands();
 
     enum continuous_horizontal_scroll_mode : uint8_t {
         HORIZONTAL_SCROLL_RIGHT = 0u,
@@ -56,10 +115,7 @@ public:
         COM_OUTPUT_SCAN_REMAPPED = 0x08u
     };
 
-    enum com_pins_hardware_configuration : uint8_t {
-        COM_PINS_HARDWARE_SEQUENTIAL  = 0u,
-        COM_PINS_HARDWARE_ALTERNATIVE = 1u
-    };
+    using com_pins_hardware_configuration = ssd1306_com_pins_configuration;
 
     enum v_comh_deselect_level : uint8_t {
         V_COMH_DESELECT_0_65 = 0x00u,
@@ -74,32 +130,76 @@ public:
     void activate_scroll(bool state);
     void set_continuous_horizontal_scroll(continuous_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page);
     void set_continuous_vertical_horizontal_scroll(continuous_vertical_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page, uint8_t offset);
-    void set_vertical_scroll_area(uint8_t fixed_rows = 0u, uint8_t scroll_rows = 64u);
+    void set_vertical_scroll_area(uint8_t fixed_rows = 0u, uint8_t scroll_rows = SCREEN_HEIGHT);
     void set_column_start_address(uint8_t address = 0u);
     void set_memory_addressing_mode(addressing_mode mode = PAGE_ADDRESSING_MODE);
-    void set_column_addresses(uint8_t start_address = 0u, uint8_t end_address = 127u);
+    void set_column_addresses(uint8_t start_address = 0u, uint8_t end_address = SCREEN_WIDTH - 1u);
     void set_page_addresses(uint8_t start_address = 0u, uint8_t end_address = NUMBER_OF_PAGES - 1u);
     void set_page_start_address(uint8_t address);
     void set_display_start_line(uint8_t line = 0u);
     void set_segmet_re_map(re_map_mode mode = RE_MAP_MODE_0);
-    void set_multiplex_ratio(uint8_t ratio = 64u);
+    void set_multiplex_ratio(uint8_t ratio = SCREEN_HEIGHT);
     void set_com_output_scan_direction(com_output_scan_direction mode = COM_OUTPUT_SCAN_NORMAL);
     void set_display_offset(uint8_t offset = 0u);
-    void set_com_pins_hardware_configuration(com_pins_hardware_configuration configuration = COM_PINS_HARDWARE_ALTERNATIVE, bool enable_remap = false);
+    void set_com_pins_hardware_configuration(com_pins_hardware_configuration configuration = COM_PINS, bool enable_remap = false);
     void set_display_clock(uint8_t clock_divider = 1u, uint8_t oscillator_frequency = 0b1000u);
     void set_pre_charge_period(uint8_t phase_1_period = 0x02u, uint8_t phase_2_period = 0x02u);
     void set_v_comh_deselect_level(v_comh_deselect_level level = V_COMH_DESELECT_0_77);
     void nop();
     void enable_charge_pump(bool state = false);
 private:
-    addressing_mode mode;
+    /* Transport created by the I2C constructor. Empty if the transport is owned by the caller. */
+    std::unique_ptr<ssd1306_transport_t> owned_transport;
+    ssd1306_transport_t& transport;
     uint8_t initialised;
-
-    enum dc_byte : uint8_t
+    /* Framebuffer with one byte of headroom in front, for the control byte of the transport. */
+    std::array<uint8_t, 1u + FRAMEBUFFER_SIZE> framebuffer_memory;
+    /* Page-major copy of the GDDRAM contents: byte (page * SCREEN_WIDTH + column) holds 8 rows, LSB on top. */
+    uint8_t* const framebuffer;
+    /* Page-major image in rotated coordinates (SCREEN_HEIGHT wide), only used for 90 and 270 degrees. */
+    std::array<uint8_t, FRAMEBUFFER_SIZE> canvas;
+    /* Rotation that is done in software: canvas columns are framebuffer rows. Flips are done by the controller. */
+    bool transposed;
+    bool flip_columns;
+    bool flip_rows;
+    /* First GDDRAM column of the panel, which moves when the segments are remapped on a panel narrower than the GDDRAM. */
+    uint8_t column_offset;
+    /* Dirty column range of each page. A start of SCREEN_WIDTH means the page is clean. */
+    std::array<uint8_t, NUMBER_OF_PAGES> dirty_start;
+    std::array<uint8_t, NUMBER_OF_PAGES> dirty_end;
+    /* Time at which the framebuffer went from clean to dirty. */
+    std::chrono::steady_clock::time_point dirty_since;
+
+    /* Controller registers that are shadowed to skip commands that would not change anything. */
+    enum shadow_register : uint8_t
     {
-        COMMAND_BYTE = 0x00u,
-        DATA_BYTE    = 0x40u
+        SHADOW_ADDRESSING_MODE,
+        SHADOW_PAGE_START,
+        SHADOW_PAGE_END,
+        SHADOW_COLUMN_START,
+        SHADOW_COLUMN_END,
+        SHADOW_CONTRAST,
+        SHADOW_INVERSE,
+        SHADOW_SCROLL_ACTIVE,
+        SHADOW_SCROLL_FIXED_ROWS,
+        SHADOW_SCROLL_ROWS,
+        SHADOW_START_LINE,
+        NUMBER_OF_SHADOW_REGISTERS
     };
+    static constexpr int16_t SHADOW_UNKNOWN = -1;
+    static constexpr uint8_t SCROLL_SETUP_SIZE = 7u;
+
+    std::array<int16_t, NUMBER_OF_SHADOW_REGISTERS> shadow;
+    /* Command bytes of the last scroll setup. A first byte of 0 means unknown. */
+    std::array<uint8_t, SCROLL_SETUP_SIZE> scroll_setup;
+    uint32_t suppressed_commands;
+
+    void write_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data);
+    void set_span_window(uint8_t page, uint8_t column_start, uint8_t column_end);
+
+    bool is_shadowed(shadow_register reg, uint8_t value);
+    void invalidate_address_windows();
+    bool write_scroll_setup(const std::array<uint8_t, SCROLL_SETUP_SIZE>& setup, uint8_t size);
 
     enum command : uint8_t
     {
@@ -133,7 +233,14 @@ private:
 
     void write_command(uint8_t command);
     void write_data(uint8_t data);
+    void write_data(const uint8_t* data, uint16_t size);
+    void write_data_in_place(uint8_t* data, uint16_t size);
     uint8_t read_data();
 };
 
+/* Panels that are explicitly instantiated. */
+using ssd1306_128x32_t = ssd1306_t<128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL>;
+using ssd1306_128x64_t = ssd1306_t<128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE>;
+using ssd1306_96x16_t  = ssd1306_t<96u, 16u, COM_PINS_HARDWARE_SEQUENTIAL>;
+
 } /* pi_zero_peripherals */
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Layout of an animation file, see ssd1306_animation.cpp for the encoding of frames. */
+static constexpr char ANIMATION_MAGIC[4] = { 'S', 'S', 'D', 'A' };
+static constexpr uint8_t ANIMATION_VERSION = 1u;
+static constexpr uint8_t ANIMATION_HEADER_SIZE = 16u;
+static constexpr uint8_t ANIMATION_FLAG_LOOP_FRAME = 0x01u;
+
+class ssd1306_animation_exception: public std::runtime_error
+{
+public:
+    ssd1306_animation_exception(const std::string& message);
+};
+
+/**
+ * @brief Encodes a sequence of page-major frames into an animation file.
+ */
+class ssd1306_animation_writer_t
+{
+public:
+    ssd1306_animation_writer_t(uint8_t width, uint8_t height, uint16_t frame_rate);
+
+    void add_frame(const uint8_t* framebuffer);
+    void save(const std::string& file_name, bool loop = true);
+private:
+    const uint8_t width;
+    const uint8_t height;
+    const uint16_t frame_rate;
+    uint32_t frame_count;
+    std::vector<uint8_t> first_frame;
+    std::vector<uint8_t> previous_frame;
+    std::vector<uint8_t> frames;
+
+    void encode_frame(const uint8_t* previous, const uint8_t* current, std::vector<uint8_t>& output);
+};
+
+/**
+ * @brief Plays an animation file on a display. The file is memory-mapped and decoded while playing,
+ * so memory usage does not depend on the length of the animation.
+ *
+ * @tparam DISPLAY Type of the display, must match the geometry of the file.
+ */
+template <typename DISPLAY>
+class ssd1306_animation_t
+{
+public:
+    ssd1306_animation_t(DISPLAY& display);
+    ~ssd1306_animation_t();
+
+    void open(const std::string& file_name);
+    void close();
+    void rewind();
+    bool next_frame(bool loop = false);
+    void play(uint16_t frame_rate = 0u, bool loop = false);
+
+    uint32_t get_frame_count();
+    uint16_t get_frame_rate();
+private:
+    DISPLAY& display;
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+    size_t second_frame_offset;
+    uint32_t frame_index;
+
+    void decode_frame();
+};
+
+} /* pi_zero_peripherals */
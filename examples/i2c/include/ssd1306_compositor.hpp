@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Work done by the compositor. */
+struct ssd1306_compositor_statistics_t
+{
+    uint32_t compositions     = 0u; /* Number of compose() calls that had damage. */
+    uint32_t columns_composed = 0u; /* Page columns (bytes) that were recomputed. */
+    uint32_t columns_changed  = 0u; /* Page columns that differed from the framebuffer and were marked dirty. */
+};
+
+/**
+ * @brief Composites layers (windows) into the framebuffer of a display and writes only what changed.
+ * Layers have a column position and a page position, so blending works on whole bytes.
+ *
+ * @tparam DISPLAY Type of the display.
+ */
+template <typename DISPLAY>
+class ssd1306_compositor_t
+{
+public:
+    enum blend_mode : uint8_t {
+        BLEND_OPAQUE      = 0u, /* The layer replaces everything below it. */
+        BLEND_TRANSPARENT = 1u, /* Only the pixels that are on are drawn. */
+        BLEND_MASKED      = 2u  /* Pixels with a set mask bit are drawn, the others show the layers below. */
+    };
+
+    ssd1306_compositor_t(DISPLAY& display);
+
+    uint8_t add_layer(uint8_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t z = 0u, blend_mode blend = BLEND_OPAQUE);
+    uint8_t* get_pixels(uint8_t layer);
+    uint8_t* get_mask(uint8_t layer);
+
+    void damage(uint8_t layer);
+    void damage(uint8_t layer, uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end);
+    void move_layer(uint8_t layer, uint8_t x, uint8_t page);
+    void set_visible(uint8_t layer, bool visible);
+    void set_z(uint8_t layer, uint8_t z);
+
+    void compose();
+    ssd1306_compositor_statistics_t get_statistics();
+private:
+    struct layer_t
+    {
+        uint8_t x;
+        uint8_t page;
+        uint8_t width;
+        uint8_t pages;
+        uint8_t z;
+        blend_mode blend;
+        bool visible;
+        std::vector<uint8_t> pixels;
+        std::vector<uint8_t> mask;
+    };
+
+    DISPLAY& display;
+    std::vector<layer_t> layers;
+    /* Damaged column range of each screen page. A start of SCREEN_WIDTH means the page is undamaged. */
+    uint8_t damage_start[DISPLAY::NUMBER_OF_PAGES];
+    uint8_t damage_end[DISPLAY::NUMBER_OF_PAGES];
+    ssd1306_compositor_statistics_t statistics;
+
+    void damage_screen(uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end);
+};
+
+} /* pi_zero_peripherals */
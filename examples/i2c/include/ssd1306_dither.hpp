@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Converts 8-bit grayscale images to the page-major 1 bit per pixel framebuffer format of the SSD1306.
+ */
+class ssd1306_dither_t
+{
+public:
+    enum dither_mode : uint8_t {
+        DITHER_THRESHOLD       = 0u,
+        DITHER_ORDERED         = 1u,
+        DITHER_FLOYD_STEINBERG = 2u,
+        DITHER_ATKINSON        = 3u
+    };
+
+    ssd1306_dither_t(uint8_t framebuffer_width, uint8_t framebuffer_height);
+
+    void convert(dither_mode mode, const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer, uint8_t x = 0u, uint8_t page = 0u);
+private:
+    const uint8_t framebuffer_width;
+    const uint8_t framebuffer_height;
+    /* Error rows for error diffusion, with a margin of two pixels on each side. */
+    std::vector<int16_t> errors;
+
+    void convert_threshold(const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer);
+    void convert_ordered(const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer);
+    void convert_error_diffusion(dither_mode mode, const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer);
+};
+
+} /* pi_zero_peripherals */
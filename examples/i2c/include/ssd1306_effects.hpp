@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Effects that run on the controller: tickers (hardware scrolling), contrast fades and blinks (inversion).
+ * Fades and blinks are a few commands on a timer, the frame itself is never resent.
+ *
+ * @tparam DISPLAY Type of the display.
+ */
+template <typename DISPLAY>
+class ssd1306_effects_t
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /* Minimum time between two contrast steps of a fade. */
+    static constexpr std::chrono::milliseconds FADE_STEP_INTERVAL{20};
+
+    ssd1306_effects_t(DISPLAY& display, uint8_t contrast = 0x7Fu);
+
+    void start_ticker(uint8_t page_start, uint8_t page_end, typename DISPLAY::continuous_horizontal_scroll_mode direction = DISPLAY::HORIZONTAL_SCROLL_LEFT,
+                      typename DISPLAY::continuous_horizontal_scroll_interval interval = DISPLAY::HORIZONTAL_SCROLL_INTERVAL_5_FRAMES);
+    void stop_ticker();
+    void fade(uint8_t contrast, std::chrono::milliseconds duration, clock::time_point now = clock::now());
+    void blink(uint8_t count, std::chrono::milliseconds period, clock::time_point now = clock::now());
+
+    bool is_active();
+    clock::time_point update(clock::time_point now = clock::now());
+    void run();
+
+    uint32_t get_steps();
+private:
+    DISPLAY& display;
+    uint32_t steps;
+
+    /* Contrast fade. */
+    bool fading;
+    uint8_t contrast;
+    uint8_t fade_from;
+    uint8_t fade_to;
+    clock::time_point fade_start;
+    clock::duration fade_duration;
+    clock::time_point fade_next;
+
+    /* Blink: remaining inversions and time of the next one. */
+    uint16_t blink_toggles;
+    bool inverted;
+    clock::duration blink_interval;
+    clock::time_point blink_next;
+};
+
+} /* pi_zero_peripherals */
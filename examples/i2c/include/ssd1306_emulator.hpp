@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../../src/i2c/include/i2c_sim_bus.hpp"
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+class ssd1306_emulator_exception: public std::runtime_error
+{
+public:
+    ssd1306_emulator_exception(const std::string& message);
+};
+
+/* Traffic received by the emulator. */
+struct ssd1306_emulator_counters_t
+{
+    uint32_t transactions  = 0u; /* Number of I2C messages. */
+    uint32_t bytes         = 0u; /* Number of bytes, including control bytes. */
+    uint32_t command_bytes = 0u; /* Number of command bytes, including arguments. */
+    uint32_t data_bytes    = 0u; /* Number of GDDRAM bytes written. */
+};
+
+/* Registers of the controller, with their reset values. */
+struct ssd1306_emulator_state_t
+{
+    uint8_t addressing_mode   = 0b10u;
+    uint8_t column_start      = 0u;
+    uint8_t column_end        = 127u;
+    uint8_t page_start        = 0u;
+    uint8_t page_end          = 7u;
+    uint8_t page_column_start = 0u;
+    uint8_t column            = 0u;
+    uint8_t page              = 0u;
+    uint8_t contrast          = 0x7Fu;
+    bool inverse              = false;
+    bool entire_display_on    = false;
+    bool display_on           = false;
+    uint8_t start_line        = 0u;
+    bool segment_remap        = false;
+    bool com_scan_remapped    = false;
+    uint8_t multiplex_ratio   = 64u;
+    uint8_t display_offset    = 0u;
+    bool com_pins_alternative = true;
+    bool com_left_right_remap = false;
+    bool charge_pump          = false;
+    uint8_t clock             = 0x80u;
+    uint8_t pre_charge_period = 0x22u;
+    uint8_t v_comh_level      = 0x20u;
+    bool scroll_active        = false;
+    uint8_t scroll_command    = 0u;
+    uint8_t scroll_start_page = 0u;
+    uint8_t scroll_interval   = 0u;
+    uint8_t scroll_end_page   = 0u;
+    uint8_t scroll_offset     = 0u;
+    uint8_t scroll_fixed_rows = 0u;
+    uint8_t scroll_rows       = 64u;
+};
+
+/**
+ * @brief Model of an SSD1306 panel on a simulated I2C bus, or behind a mock SPI device.
+ * Decodes control bytes, commands and GDDRAM writes, and renders what the panel would show.
+ */
+class ssd1306_emulator_t : public i2c_sim_device_t
+{
+public:
+    static constexpr uint8_t GDDRAM_WIDTH = 128u;
+    static constexpr uint8_t GDDRAM_PAGES = 8u;
+
+    ssd1306_emulator_t(uint8_t width, uint8_t height, ssd1306_com_pins_configuration wiring);
+
+    bool i2c_sim_write(const uint8_t* data, uint16_t size) override;
+    bool i2c_sim_read(uint8_t* buffer, uint16_t size) override;
+    void spi_sim_write(const uint8_t* data, uint32_t size, bool dc);
+
+    std::vector<uint8_t> render();
+    void save_pbm(const std::string& file_name);
+    void save_png(const std::string& file_name);
+    void step_scroll();
+    void reset_counters();
+
+    const uint8_t* get_gddram();
+
+    ssd1306_emulator_state_t state;
+    ssd1306_emulator_counters_t counters;
+private:
+    const uint8_t width;
+    const uint8_t height;
+    const ssd1306_com_pins_configuration wiring;
+    uint8_t gddram[GDDRAM_PAGES * GDDRAM_WIDTH];
+    /* Command that is waiting for its arguments. */
+    std::vector<uint8_t> command;
+    /* D/C bit of the last control byte (or D/C pin on SPI), selects what is read. */
+    bool data_mode;
+    /* Rows moved by vertical scrolling. */
+    uint8_t scroll_line;
+
+    void write_command_byte(uint8_t byte);
+    void execute_command();
+    void write_data_byte(uint8_t byte);
+    uint8_t read_data_byte();
+    uint8_t segment();
+    void advance_pointer();
+};
+
+} /* pi_zero_peripherals */
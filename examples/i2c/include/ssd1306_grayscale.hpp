@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Results of driving a grayscale frame. */
+struct ssd1306_grayscale_statistics_t
+{
+    uint32_t subframes         = 0u;    /* Number of bitplanes shown. */
+    uint32_t bytes             = 0u;    /* Number of GDDRAM bytes written. */
+    double subframes_per_second = 0.0;  /* Achieved bitplane rate. */
+    double cycles_per_second   = 0.0;   /* Achieved rate of complete grayscale frames. */
+    bool flicker_free          = false; /* True if the grayscale frame rate is above the flicker fusion threshold. */
+};
+
+/**
+ * @brief Shows a few levels of gray on a monochrome SSD1306 by alternating bitplanes as fast as the bus allows.
+ *
+ * @tparam DISPLAY Type of the display.
+ */
+template <typename DISPLAY>
+class ssd1306_grayscale_t
+{
+public:
+    /* Grayscale frame rate above which flicker is not visible. */
+    static constexpr double FLICKER_FUSION_HZ = 50.0;
+
+    ssd1306_grayscale_t(DISPLAY& display, uint8_t bits = 2u);
+
+    void set_frame(const uint8_t levels[DISPLAY::SCREEN_HEIGHT][DISPLAY::SCREEN_WIDTH]);
+    void show_subframe();
+    ssd1306_grayscale_statistics_t run(std::chrono::milliseconds duration);
+
+    uint8_t get_subframe_count();
+private:
+    DISPLAY& display;
+    const uint8_t subframe_count;
+    uint8_t subframe;
+    uint32_t bytes;
+    /* Page-major bitplane of every subframe. */
+    std::vector<uint8_t> bitplanes;
+};
+
+} /* pi_zero_peripherals */
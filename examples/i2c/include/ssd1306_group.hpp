@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Flush statistics of a single panel in a display group. */
+struct ssd1306_panel_statistics_t
+{
+    uint32_t frames           = 0u;  /* Number of frames that were completely written. */
+    uint32_t bytes            = 0u;  /* Number of GDDRAM bytes written. */
+    double average_latency_ms = 0.0; /* Average time between a frame being marked dirty and being completely written. */
+    double max_latency_ms     = 0.0; /* Worst case of the above. */
+};
+
+/* Flush statistics of a display group. */
+struct ssd1306_group_statistics_t
+{
+    double frames_per_second = 0.0; /* Completed frames per second, summed over all panels. */
+    uint32_t bytes           = 0u;  /* Number of GDDRAM bytes written to all panels. */
+    std::vector<ssd1306_panel_statistics_t> panels;
+};
+
+/**
+ * @brief Schedules the flushes of several SSD1306 panels that share one I2C bus.
+ * Dirty spans of the panels are written in round-robin order, so a large update on one panel
+ * cannot starve the others. Panels can mirror another panel, and panels can be combined into
+ * a canvas that spans them from left to right.
+ *
+ * @tparam DISPLAY Type of the panels, e.g. ssd1306_128x32_t.
+ */
+template <typename DISPLAY>
+class ssd1306_group_t
+{
+public:
+    /* Source index of a panel that does not mirror another panel. */
+    static constexpr uint8_t NO_SOURCE = 0xFFu;
+
+    ssd1306_group_t();
+
+    uint8_t add_panel(DISPLAY& panel);
+    void mirror(uint8_t source, uint8_t target);
+    void add_to_canvas(uint8_t panel);
+    void initialise();
+
+    bool flush_step();
+    void flush();
+
+    uint16_t get_canvas_width();
+    void set_canvas_pixel(uint16_t x, uint8_t y, bool value);
+    void clear_canvas();
+
+    ssd1306_group_statistics_t get_statistics();
+    void reset_statistics();
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct panel_t
+    {
+        DISPLAY* display;
+        uint8_t source;
+        bool pending;
+        clock::time_point pending_since;
+        ssd1306_panel_statistics_t statistics;
+        double total_latency_ms;
+    };
+
+    std::vector<panel_t> panels;
+    std::vector<uint8_t> canvas;
+    uint8_t next_panel;
+    clock::time_point statistics_start;
+
+    void complete_frame(uint8_t panel, clock::time_point now);
+};
+
+} /* pi_zero_peripherals */
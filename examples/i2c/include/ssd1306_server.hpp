@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <sys/types.h>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+class ssd1306_server_exception: public std::runtime_error
+{
+public:
+    ssd1306_server_exception(const std::string& message);
+};
+
+/* A layer in the shared memory of the display server. */
+struct ssd1306_shm_layer_t
+{
+    static constexpr uint8_t MAX_COLUMNS = 128u;
+    static constexpr uint8_t MAX_PAGES = 8u;
+    static constexpr uint16_t CLEAN = 0x00FFu;
+
+    std::atomic<uint32_t> owner;                /* Process ID of the client, 0 if the layer is free. */
+    std::atomic<uint8_t> visible;               /* 1 if the layer is composited. */
+    std::atomic<uint8_t> z;                     /* Layers with a higher z are on top. */
+    std::atomic<uint16_t> damage[MAX_PAGES];    /* Per page: first column | last column << 8, CLEAN if undamaged. */
+    uint8_t pixels[MAX_PAGES * MAX_COLUMNS];    /* Page-major image, rows of width columns like the framebuffer. */
+    uint8_t mask[MAX_PAGES * MAX_COLUMNS];      /* Page-major mask, a set bit means the layer covers the pixel. */
+};
+
+/* Shared memory of the display server. */
+struct ssd1306_shm_t
+{
+    static constexpr uint32_t MAGIC = 0x53534453u; /* "SDSS" */
+    static constexpr uint8_t MAX_LAYERS = 8u;
+
+    uint32_t magic;
+    uint8_t width;
+    uint8_t pages;
+    std::atomic<uint32_t> damage_sequence;         /* Futex word, incremented by every damage notification. */
+    std::atomic<uint32_t> server_waiting;          /* 1 while the server sleeps on the futex. */
+    ssd1306_shm_layer_t layers[MAX_LAYERS];
+};
+
+/**
+ * @brief Display server: owns the display and composites the layers of its clients, which are in shared memory.
+ *
+ * @tparam DISPLAY Type of the display.
+ */
+template <typename DISPLAY>
+class ssd1306_server_t
+{
+public:
+    ssd1306_server_t(DISPLAY& display, const std::string& name = "/ssd1306", mode_t mode = 0600);
+    ~ssd1306_server_t();
+
+    bool process();
+    bool wait(std::chrono::milliseconds timeout);
+    void run(const std::atomic<bool>& stop);
+private:
+    DISPLAY& display;
+    const std::string name;
+    ssd1306_shm_t* shm;
+
+    void reap_layers();
+};
+
+/**
+ * @brief Client of the display server. Draws in its own layer, without system calls.
+ */
+class ssd1306_client_t
+{
+public:
+    ssd1306_client_t(const std::string& name = "/ssd1306", uint8_t z = 0u);
+    ~ssd1306_client_t();
+
+    uint8_t* get_pixels();
+    uint8_t* get_mask();
+    uint8_t get_width();
+    uint8_t get_pages();
+
+    void set_visible(bool visible);
+    void set_z(uint8_t z);
+    void damage(uint8_t column_start = 0u, uint8_t page_start = 0u, uint8_t column_end = 0xFFu, uint8_t page_end = 0xFFu);
+private:
+    ssd1306_shm_t* shm;
+    ssd1306_shm_layer_t* layer;
+
+    void notify();
+};
+
+} /* pi_zero_peripherals */
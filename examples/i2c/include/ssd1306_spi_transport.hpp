@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ssd1306_transport.hpp"
+#include "../../../src/gpio/include/gpio_pin.hpp"
+#include "../../../src/spi/include/spi_device.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief SSD1306 on a 4-wire SPI bus. The D/C pin selects command or data, the serial interface is write-only.
+ */
+class ssd1306_spi_transport_t : public ssd1306_transport_t
+{
+public:
+    ssd1306_spi_transport_t(spi_device_t& device, gpio_pin_t& dc_pin, gpio_pin_t& reset_pin);
+
+    void initialise() override;
+    void reset();
+    void write_commands(const uint8_t* commands, uint16_t size) override;
+    void write_data(const uint8_t* data, uint16_t size) override;
+    uint8_t read_status() override;
+    uint8_t read_data() override;
+private:
+    spi_device_t& device;
+    gpio_pin_t& dc_pin;
+    gpio_pin_t& reset_pin;
+};
+
+} /* pi_zero_peripherals */
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "ssd1306.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Sprite with its 8 vertical shift variants precomputed in page-major layout, with masks.
+ * A sprite at any y is then a variant at a page boundary, so drawing it needs no bit shifts.
+ */
+class ssd1306_sprite_t
+{
+public:
+    static constexpr uint8_t SHIFTS = 8u;
+
+    ssd1306_sprite_t(uint8_t width, uint8_t height, const uint8_t* pixels, const uint8_t* mask = nullptr);
+
+    uint8_t get_width() const;
+    uint8_t get_height() const;
+    uint8_t get_pages(uint8_t shift) const;
+    const uint8_t* get_pixels(uint8_t shift) const;
+    const uint8_t* get_mask(uint8_t shift) const;
+
+    bool collides(int16_t x, int16_t y, const ssd1306_sprite_t& other, int16_t other_x, int16_t other_y) const;
+private:
+    const uint8_t width;
+    const uint8_t height;
+    /* Pages of one variant in the storage, enough for the largest shift. */
+    const uint8_t variant_pages;
+    /* Variants one after the other, each variant_pages rows of width columns. Pixels are already masked. */
+    std::vector<uint8_t> pixels;
+    std::vector<uint8_t> mask;
+};
+
+/**
+ * @brief Draws sprites into the framebuffer of a display and marks what they touch as dirty.
+ * Coordinates are framebuffer (GDDRAM) coordinates, sprites may be partly off screen.
+ *
+ * @tparam DISPLAY Type of the display.
+ */
+template <typename DISPLAY>
+class ssd1306_sprite_engine_t
+{
+public:
+    ssd1306_sprite_engine_t(DISPLAY& display);
+
+    void draw(const ssd1306_sprite_t& sprite, int16_t x, int16_t y);
+    void erase(const ssd1306_sprite_t& sprite, int16_t x, int16_t y);
+    bool overlaps(const ssd1306_sprite_t& sprite, int16_t x, int16_t y);
+private:
+    DISPLAY& display;
+
+    template <typename OPERATION>
+    bool blit(const ssd1306_sprite_t& sprite, int16_t x, int16_t y, bool mark_dirty, OPERATION operation);
+};
+
+} /* pi_zero_peripherals */
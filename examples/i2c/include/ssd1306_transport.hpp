@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../../../src/i2c/include/i2c_device.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Link between ssd1306_t and the controller. Commands and GDDRAM data are sent as separate writes,
+ * the transport adds whatever is needed to tell them apart (a control byte on I2C, the D/C pin on SPI).
+ */
+class ssd1306_transport_t
+{
+public:
+    virtual ~ssd1306_transport_t() = default;
+
+    virtual void initialise() = 0;
+    virtual void write_commands(const uint8_t* commands, uint16_t size) = 0;
+    virtual void write_data(const uint8_t* data, uint16_t size) = 0;
+    virtual void write_data_in_place(uint8_t* data, uint16_t size);
+    virtual uint8_t read_status() = 0;
+    virtual uint8_t read_data() = 0;
+};
+
+/**
+ * @brief SSD1306 on an I2C bus. Every write starts with a control byte that selects command or data.
+ */
+class ssd1306_i2c_transport_t : public ssd1306_transport_t, public i2c_device_t
+{
+public:
+    static constexpr uint8_t ADDRESS_BASE = 0b0111100u;
+    /* Data bytes per I2C message. */
+    static constexpr uint16_t MAX_MESSAGE_SIZE = 128u;
+
+    ssd1306_i2c_transport_t(i2c_bus_t& bus, uint8_t address_lsb = 0u);
+
+    void initialise() override;
+    void write_commands(const uint8_t* commands, uint16_t size) override;
+    void write_data(const uint8_t* data, uint16_t size) override;
+    void write_data_in_place(uint8_t* data, uint16_t size) override;
+    uint8_t read_status() override;
+    uint8_t read_data() override;
+private:
+    enum dc_byte : uint8_t
+    {
+        COMMAND_BYTE = 0x00u,
+        DATA_BYTE    = 0x40u
+    };
+};
+
+} /* pi_zero_peripherals */
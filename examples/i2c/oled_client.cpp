@@ -0,0 +1,42 @@
+/**
+ * @file oled_client.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Client of oled_server: draws a bar that grows every second in a page of its own layer.
+ * @date 18-10-2026
+ *
+ * Usage: oled_client [page] [z]
+ */
+
+#include <chrono>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#include "include/ssd1306_server.hpp"
+
+using namespace pi_zero_peripherals;
+
+int main(int argc, char* argv[])
+{
+    const uint8_t page = argc > 1 ? atoi(argv[1]) : 0u;
+    const uint8_t z = argc > 2 ? atoi(argv[2]) : 0u;
+    ssd1306_client_t client("/ssd1306", z);
+    const uint8_t width = client.get_width();
+
+    /* The layer covers its page. */
+    memset(&client.get_mask()[page * width], 0xFF, width);
+
+    for (uint8_t length = 1u; ; length = length % width + 1u)
+    {
+        uint8_t* pixels = &client.get_pixels()[page * width];
+
+        memset(pixels, 0x3C, length);
+        memset(pixels + length, 0x00, width - length);
+        client.damage(0u, page, width - 1u, page);
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file oled_server.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Display server for a 128x32 display on I2C bus 1. Clients connect with ssd1306_client_t, see oled_client.cpp.
+ * @date 18-10-2026
+ */
+
+#include <iostream>
+#include <signal.h>
+
+#include "include/ssd1306_server.hpp"
+
+using namespace pi_zero_peripherals;
+
+static std::atomic<bool> stop(false);
+
+int main()
+{
+    i2c_bus_t i2c_bus(1u);
+    ssd1306_128x32_t ssd1306(i2c_bus);
+
+    ssd1306.initialise();
+
+    ssd1306_server_t<ssd1306_128x32_t> server(ssd1306);
+
+    signal(SIGINT, [](int) { stop = true; });
+    signal(SIGTERM, [](int) { stop = true; });
+
+    std::cout << "Serving /ssd1306, press Ctrl+C to stop." << std::endl;
+    server.run(stop);
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file oled_spi_example.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Shows a checkerboard on a 128x64 SSD1306 on SPI0 (CE0), with D/C on GPIO24 and RES on GPIO25.
+ * @date 18-10-2026
+ */
+
+#include <iostream>
+
+#include "include/ssd1306.hpp"
+#include "include/ssd1306_spi_transport.hpp"
+
+using namespace pi_zero_peripherals;
+
+int main()
+{
+    spi_device_t spi_device(0u, 0u);
+    ssd1306_spi_transport_t transport(spi_device, GPIO24, GPIO25);
+    ssd1306_128x64_t ssd1306(transport);
+    uint8_t pixels[ssd1306_128x64_t::SCREEN_HEIGHT][ssd1306_128x64_t::SCREEN_WIDTH];
+
+    ssd1306.initialise();
+
+    for (size_t y = 0; y < ssd1306_128x64_t::SCREEN_HEIGHT; y++)
+    {
+        for (size_t x = 0; x < ssd1306_128x64_t::SCREEN_WIDTH; x++)
+        {
+            pixels[y][x] = ((x / 8u) ^ (y / 8u)) & 1u;
+        }
+    }
+
+    ssd1306.display(pixels);
+
+    std::cout << "Checkerboard written over SPI, press enter to exit." << std::endl;
+    std::cin.get();
+
+    return 0;
+}
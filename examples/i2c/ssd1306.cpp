@@ -4,23 +4,17 @@
  * @brief Driver for the SSD1306 128x64 monochrome OLED display
  * @date 06-04-2022
  *
- * In this example, the display uses a 128x32 pixel matrix.
+ * The panel geometry (width, height and COM pins configuration) is a template parameter,
+ * e.g. 128x32, 128x64 or 96x16. All supported panels are instantiated at the bottom of this file.
  * The device uses GDDRAM to store the state of the screen, with one bit
- * for each pixel (1 = on, 0 = off). These bits are divided into 8 pages,
+ * for each pixel (1 = on, 0 = off). These bits are divided into up to 8 pages,
  * and each page has an 8x128 matrix of pixels.
  *
  * The device uses a column pointer and a page pointer. When writing a byte to a page, the byte will be written to the first column
  * of the page by default. The column pointer is then increased. This is the page addressing mode.
  * For other addressing modes, see pages 34-35 of the SSD1306 manual.
  *
- * After sending the slave address (done by libi2c), we need to send
- * a control byte <Co, D/C, 0, 0, 0, 0, 0, 0>.
- * - If Co == 0, all following bytes are data bytes.
- * - If Co == 1, following bytes may contain control bytes.
- * - If D/C == 0, all following data bytes are a command.
- * - If D/C == 1, all following data bytes are written to the GDDRAM.
- *
- * Using the Co bit, we could potentially write several commands at the same time.
+ * Commands and data are written through a transport, see ssd1306_transport.cpp (I2C) and ssd1306_spi_transport.cpp (SPI).
  * Some commands require writing multiple bytes. The commands can be found on pages 28-32
  * of the SSD1306 manual. Detailed descriptions of each command are on pages 34-46.
  *
@@ -29,10 +23,20 @@
  * We should only write values to the GDDRAM when the FR signal is detected.
  * However, the board that the display is on doesn't provide an interface to this signal so we can't detect it.
  *
+ * The driver keeps a shadow of the controller registers that are changed during normal operation
+ * (addressing mode, address windows, contrast, inversion, scrolling and start line).
+ * Commands that would write the value the register already has are not sent.
+ * Skipping the address window commands is only correct if the GDDRAM pointer is at the start of the window.
+ * All data writes of the driver exactly fill the window, after which the pointer wraps around to the start.
+ * Anything that leaves the pointer elsewhere invalidates the shadowed windows.
+ *
  * TODO: create function for specifying frames per second using the formula on page 22 of the data sheet.
  */
 
+#include <algorithm>
 #include <assert.h>
+#include <functional>
+#include <string.h>
 
 #include "include/ssd1306.hpp"
 
@@ -44,31 +48,73 @@ using namespace pi_zero_peripherals;
  * @param bus I2C bus that the device is on.
  * @param address_lsb LSB of the slave address. Can be 0 or 1 depending on the SA0 pin.
  */
-ssd1306_t::ssd1306_t(i2c_bus_t& bus, uint8_t address_lsb) :
-    i2c_device_t(bus, ADDRESS_BASE | address_lsb)
-{}
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+ssd1306_t<WIDTH, HEIGHT, COM_PINS>::ssd1306_t(i2c_bus_t& bus, uint8_t address_lsb) :
+    owned_transport(new ssd1306_i2c_transport_t(bus, address_lsb)),
+    transport(*owned_transport),
+    initialised(0u),
+    framebuffer_memory{},
+    framebuffer(&framebuffer_memory[1]),
+    canvas{},
+    transposed(false),
+    flip_columns(false),
+    flip_rows(false),
+    column_offset(0u),
+    suppressed_commands(0u)
+{
+    this->dirty_start.fill(SCREEN_WIDTH);
+    this->dirty_end.fill(0u);
+    this->invalidate_shadow();
+}
+
+/**
+ * @brief Construct a new ssd1306_t object that uses a transport owned by the caller, e.g. ssd1306_spi_transport_t.
+ *
+ * @param transport Transport to the controller. Must outlive the ssd1306_t object.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+ssd1306_t<WIDTH, HEIGHT, COM_PINS>::ssd1306_t(ssd1306_transport_t& transport) :
+    transport(transport),
+    initialised(0u),
+    framebuffer_memory{},
+    framebuffer(&framebuffer_memory[1]),
+    canvas{},
+    transposed(false),
+    flip_columns(false),
+    flip_rows(false),
+    column_offset(0u),
+    suppressed_commands(0u)
+{
+    this->dirty_start.fill(SCREEN_WIDTH);
+    this->dirty_end.fill(0u);
+    this->invalidate_shadow();
+}
 
 /**
  * @brief Initialises the SSD1306 OLED module. Uses the software initialisation example
  * on page 64 of the data sheet:
- * 1.  Set MUX ratio to default (64).
+ * 1.  Set MUX ratio to the panel height.
  * 2.  Set display offset to default (0).
  * 3.  Set display start line to default (0).
- * 4.  Set segment re-map to default (0).
- * 5.  Set COM output scan direction to default (normal).
- * 6.  Set COM pins hardware configuration to sequential.
+ * 4.  Set segment re-map according to the orientation (default 0).
+ * 5.  Set COM output scan direction according to the orientation (default normal).
+ * 6.  Set COM pins hardware configuration of the panel.
  * 7.  Set contrast control to default (127).
  * 8.  Set display to default (normal).
  * 9.  Set oscillator frequency to default (8).
  * 10. Enable charge pump regulator.
  * 11. Enable display.
  */
-void ssd1306_t::initialise()
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::initialise()
 {
     assert(!this->initialised);
 
-    /* Initialise the I2C bus. */
-    this->bus.initialise();
+    /* Initialise the transport, e.g. open the bus. */
+    this->transport.initialise();
+
+    /* The state of the controller is unknown until it has been initialised. */
+    this->invalidate_shadow();
 
     /* Disable display for initialisation. */
     this->enable_display(false);
@@ -77,9 +123,9 @@ void ssd1306_t::initialise()
     this->set_multiplex_ratio();
     this->set_display_offset();
     this->set_display_start_line();
-    this->set_segmet_re_map();
-    this->set_com_output_scan_direction();
-    this->set_com_pins_hardware_configuration(COM_PINS_HARDWARE_SEQUENTIAL);
+    this->set_segmet_re_map(this->flip_columns ? RE_MAP_MODE_127 : RE_MAP_MODE_0);
+    this->set_com_output_scan_direction(this->flip_rows ? COM_OUTPUT_SCAN_REMAPPED : COM_OUTPUT_SCAN_NORMAL);
+    this->set_com_pins_hardware_configuration();
     this->set_contrast();
     this->set_inverse_display();
     /* Charge pump enabled because V_bat is 3.3V. */
@@ -97,19 +143,15 @@ void ssd1306_t::initialise()
 
 /**
  * @brief Displays data on the OLED display.
+ * The pixel data is converted to the page-major framebuffer, which is then written to the display.
  *
  * @param display_data A 2D array of data to display on the screen.
- *
- * TODO: allow writing of variable sized data at dynamic screen position.
  */
-void ssd1306_t::display(uint8_t display_data[SCREEN_HEIGHT][SCREEN_WIDTH])
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::display(uint8_t display_data[SCREEN_HEIGHT][SCREEN_WIDTH])
 {
-    /* Set addressing mode to horizontal: auto-wrap of page and column addresses. */
-    this->set_memory_addressing_mode(HORIZONTAL_ADDRESSING_MODE);
-    /* Set page addresses to default, increased automatically. */
-    this->set_page_addresses();
-    /* Set column addresses to default, increased automatically. */
-    this->set_column_addresses();
+    /* A rotated image does not fit the array, use display_region() or the canvas. */
+    assert(!this->transposed);
 
     /* Loop over pages. */
     for (size_t page = 0; page < NUMBER_OF_PAGES; page++)
@@ -122,23 +164,432 @@ void ssd1306_t::display(uint8_t display_data[SCREEN_HEIGHT][SCREEN_WIDTH])
             /* Extract column data from display data. */
             for (size_t pixel = 0; pixel < 8u; pixel++)
             {
-                data |= display_data[page * 8 + pixel][column] << pixel;
+                data |= (display_data[page * 8 + pixel][column] & 1u) << pixel;
+            }
+
+            this->framebuffer[page * SCREEN_WIDTH + column] = data;
+        }
+    }
+
+    this->display_framebuffer();
+}
+
+/**
+ * @brief Displays a rectangle of pixel data at a position on the screen, in the coordinates of the orientation.
+ * Only the pages and columns of the rectangle are written, e.g. 32 bytes for a page-aligned 16x16 icon.
+ *
+ * @param x Column of the left edge.
+ * @param y Row of the top edge.
+ * @param width Width of the rectangle in pixels.
+ * @param height Height of the rectangle in pixels.
+ * @param data Row-major pixel data of width * height bytes, one pixel per byte (1 = on).
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::display_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data)
+{
+    if (!this->transposed)
+    {
+        this->write_region(x, y, width, height, data);
+        return;
+    }
+
+    assert(width > 0u && x + width <= SCREEN_HEIGHT);
+    assert(height > 0u && y + height <= SCREEN_WIDTH);
+
+    uint8_t transposed_data[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+    for (size_t row = 0; row < height; row++)
+    {
+        for (size_t column = 0; column < width; column++)
+        {
+            const uint8_t pixel = data[row * width + column] & 1u;
+            uint8_t& byte = this->canvas[((y + row) / 8u) * SCREEN_HEIGHT + x + column];
+            const uint8_t bit = 1u << ((y + row) % 8u);
+
+            /* Keep the canvas up to date, so that the next present() does not undo the region. */
+            byte = pixel ? (byte | bit) : (byte & ~bit);
+            transposed_data[column * height + row] = pixel;
+        }
+    }
+
+    /* Canvas rows are framebuffer columns. */
+    this->write_region(y, x, height, width, transposed_data);
+}
+
+/**
+ * @brief Writes a rectangle of pixel data in framebuffer coordinates.
+ * The rectangle is converted into the framebuffer. Rows of the pages it touches that lie outside the rectangle
+ * keep their framebuffer contents. Then the address window is set to the pages and columns of the rectangle,
+ * and only those bytes are written in a single burst, e.g. 32 bytes for a page-aligned 16x16 icon.
+ *
+ * @param x Column of the left edge.
+ * @param y Row of the top edge.
+ * @param width Width of the rectangle in pixels.
+ * @param height Height of the rectangle in pixels.
+ * @param data Row-major pixel data of width * height bytes, one pixel per byte (1 = on).
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_region(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data)
+{
+    assert(width > 0u && x + width <= SCREEN_WIDTH);
+    assert(height > 0u && y + height <= SCREEN_HEIGHT);
+
+    const uint8_t page_start = y / 8u;
+    const uint8_t page_end = (y + height - 1u) / 8u;
+    /* The rectangle is not contiguous in the framebuffer, so it is gathered behind a byte of headroom. */
+    uint8_t buffer[1u + FRAMEBUFFER_SIZE];
+    uint16_t size = 1u;
+
+    for (size_t page = page_start; page <= page_end; page++)
+    {
+        /* Rows of this page that are covered by the rectangle. */
+        const uint8_t row_start = std::max<int>(y, page * 8u);
+        const uint8_t row_end = std::min<int>(y + height, page * 8u + 8u);
+        const uint8_t mask = (0xFFu << (row_start - page * 8u)) & (0xFFu >> (page * 8u + 8u - row_end));
+
+        for (size_t column = x; column < x + width; column++)
+        {
+            uint8_t bits = 0u;
+
+            for (size_t row = row_start; row < row_end; row++)
+            {
+                bits |= (data[(row - y) * width + column - x] & 1u) << (row - page * 8u);
             }
 
-            /* Write data to SSD1306. */
-            this->write_data(data);
+            /* Merge with the rows of the page that are outside the rectangle. */
+            uint8_t& byte = this->framebuffer[page * SCREEN_WIDTH + column];
+            byte = (byte & ~mask) | bits;
+            buffer[size++] = byte;
         }
     }
+
+    this->set_memory_addressing_mode(HORIZONTAL_ADDRESSING_MODE);
+    this->set_page_addresses(page_start, page_end);
+    this->set_column_addresses(this->column_offset + x, this->column_offset + x + width - 1u);
+
+    this->write_data_in_place(&buffer[1], size - 1u);
+}
+
+/**
+ * @brief Writes the framebuffer to the display in a single data write.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::display_framebuffer()
+{
+    /* Set addressing mode to horizontal: auto-wrap of page and column addresses. */
+    this->set_memory_addressing_mode(HORIZONTAL_ADDRESSING_MODE);
+    /* Set page addresses to default, increased automatically. */
+    this->set_page_addresses();
+    /* Set column addresses to the columns of the panel, increased automatically. */
+    this->set_column_addresses(this->column_offset, this->column_offset + SCREEN_WIDTH - 1u);
+
+    /* The window covers the whole GDDRAM, so the transport can send the frame in as few transfers as it likes. */
+    this->write_data_in_place(this->framebuffer, FRAMEBUFFER_SIZE);
+
+    /* The display now matches the framebuffer. */
+    this->dirty_start.fill(SCREEN_WIDTH);
+    this->dirty_end.fill(0u);
 }
 
 /**
  * @brief Clear the OLED screen by setting all data to 0.
  */
-void ssd1306_t::clear_screen()
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::clear_screen()
+{
+    std::fill_n(this->framebuffer, FRAMEBUFFER_SIZE, 0u);
+
+    this->display_framebuffer();
+}
+
+/**
+ * @brief Get the framebuffer. Changes are written to the display by display_framebuffer().
+ *
+ * @return uint8_t* Page-major framebuffer of FRAMEBUFFER_SIZE bytes.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t* ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_framebuffer()
+{
+    return this->framebuffer;
+}
+
+/**
+ * @brief Set the orientation of the image. Flips are done by the controller with the segment re-map and the COM
+ * output scan direction, so 0 and 180 degrees cost nothing. 90 and 270 degrees also need a transpose, which is done
+ * in software: draw in the canvas (SCREEN_HEIGHT wide, SCREEN_WIDTH high) and call present().
+ * The screen is cleared, because the segment re-map only applies to data written after it.
+ * Before initialise() the orientation is only stored, and applied by the initialisation sequence.
+ *
+ * @param rotation Clockwise rotation.
+ * @param mirror If true, the image is mirrored left to right after the rotation.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_orientation(orientation rotation, bool mirror)
+{
+    /* Canvas pages are framebuffer columns. */
+    assert(rotation == ORIENTATION_0 || rotation == ORIENTATION_180 || SCREEN_WIDTH % 8u == 0u);
+
+    this->transposed = rotation == ORIENTATION_90 || rotation == ORIENTATION_270;
+    this->flip_columns = rotation == ORIENTATION_90 || rotation == ORIENTATION_180;
+    this->flip_rows = rotation == ORIENTATION_180 || rotation == ORIENTATION_270;
+
+    /* Canvas columns run along the framebuffer rows when transposed. */
+    if (mirror)
+    {
+        (this->transposed ? this->flip_rows : this->flip_columns) ^= true;
+    }
+
+    this->canvas.fill(0u);
+
+    if (!this->initialised)
+    {
+        return;
+    }
+
+    this->set_segmet_re_map(this->flip_columns ? RE_MAP_MODE_127 : RE_MAP_MODE_0);
+    this->set_com_output_scan_direction(this->flip_rows ? COM_OUTPUT_SCAN_REMAPPED : COM_OUTPUT_SCAN_NORMAL);
+    this->clear_screen();
+}
+
+/**
+ * @brief Get the image to draw in. This is the framebuffer, unless the orientation is 90 or 270 degrees.
+ *
+ * @return uint8_t* Page-major image of get_canvas_width() by get_canvas_height() pixels.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t* ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_canvas()
+{
+    return this->transposed ? this->canvas.data() : this->framebuffer;
+}
+
+/**
+ * @brief Get the width of the canvas in pixels.
+ *
+ * @return uint8_t Width of the canvas.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_canvas_width()
+{
+    return this->transposed ? SCREEN_HEIGHT : SCREEN_WIDTH;
+}
+
+/**
+ * @brief Get the height of the canvas in pixels.
+ *
+ * @return uint8_t Height of the canvas.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_canvas_height()
+{
+    return this->transposed ? SCREEN_WIDTH : SCREEN_HEIGHT;
+}
+
+/**
+ * @brief Transpose an 8x8 bit matrix, packed one row per byte (Hacker's Delight, section 7-3).
+ *
+ * @param x Matrix to transpose.
+ * @return uint64_t Transposed matrix.
+ */
+static inline uint64_t transpose_8x8(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7u)) & 0x00AA00AA00AA00AAull;
+    x = x ^ t ^ (t << 7u);
+    t = (x ^ (x >> 14u)) & 0x0000CCCC0000CCCCull;
+    x = x ^ t ^ (t << 14u);
+    t = (x ^ (x >> 28u)) & 0x00000000F0F0F0F0ull;
+    x = x ^ t ^ (t << 28u);
+
+    return x;
+}
+
+/**
+ * @brief Show the canvas. When the orientation is 90 or 270 degrees, the canvas is transposed into the framebuffer
+ * one 8x8 block at a time, and blocks that changed are marked dirty. Then all dirty spans are written.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::present()
+{
+    if (this->transposed)
+    {
+        for (size_t canvas_page = 0; canvas_page < SCREEN_WIDTH / 8u; canvas_page++)
+        {
+            for (size_t page = 0; page < NUMBER_OF_PAGES; page++)
+            {
+                uint64_t block;
+                uint8_t* destination = &this->framebuffer[page * SCREEN_WIDTH + canvas_page * 8u];
+
+                /* Canvas columns page * 8 up to page * 8 + 7 become the rows of framebuffer page. */
+                memcpy(&block, &this->canvas[canvas_page * SCREEN_HEIGHT + page * 8u], 8u);
+                block = transpose_8x8(block);
+
+                if (memcmp(destination, &block, 8u) != 0)
+                {
+                    memcpy(destination, &block, 8u);
+                    this->mark_dirty(canvas_page * 8u, page, canvas_page * 8u + 7u, page);
+                }
+            }
+        }
+    }
+
+    this->flush();
+}
+
+/**
+ * @brief Mark a rectangle of the framebuffer as changed, so that it is written by the next flush.
+ *
+ * @param column_start First changed column.
+ * @param page_start First changed page.
+ * @param column_end Last changed column.
+ * @param page_end Last changed page.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::mark_dirty(uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end)
+{
+    assert(column_start <= column_end && column_end < SCREEN_WIDTH);
+    assert(page_start <= page_end && page_end < NUMBER_OF_PAGES);
+
+    /* Only the first change after a flush starts the clock, so the time is not read for every pixel. */
+    if (!this->is_dirty())
+    {
+        this->dirty_since = std::chrono::steady_clock::now();
+    }
+
+    for (size_t page = page_start; page <= page_end; page++)
+    {
+        this->dirty_start[page] = std::min(this->dirty_start[page], column_start);
+        this->dirty_end[page] = std::max(this->dirty_end[page], column_end);
+    }
+}
+
+/**
+ * @brief Check whether the framebuffer contains changes that are not on the display yet.
+ *
+ * @return true if any page is dirty.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+bool ssd1306_t<WIDTH, HEIGHT, COM_PINS>::is_dirty()
+{
+    for (size_t page = 0; page < NUMBER_OF_PAGES; page++)
+    {
+        if (this->dirty_start[page] < SCREEN_WIDTH)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Get the time at which the framebuffer was marked dirty while it was clean,
+ * i.e. the time of the oldest change that is not on the display yet.
+ *
+ * @return std::chrono::steady_clock::time_point Time of the oldest unwritten change, only meaningful while the
+ * framebuffer is dirty.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+std::chrono::steady_clock::time_point ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_dirty_since()
+{
+    return this->dirty_since;
+}
+
+/**
+ * @brief Take the first dirty span (the changed columns of a single page) and mark it clean.
+ * The caller is responsible for writing the span to the display.
+ *
+ * @param page Set to the page of the span.
+ * @param column_start Set to the first column of the span.
+ * @param column_end Set to the last column of the span.
+ * @return true if a dirty span was found, false if the framebuffer is clean.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+bool ssd1306_t<WIDTH, HEIGHT, COM_PINS>::take_dirty_span(uint8_t& page, uint8_t& column_start, uint8_t& column_end)
+{
+    for (size_t i = 0; i < NUMBER_OF_PAGES; i++)
+    {
+        if (this->dirty_start[i] < SCREEN_WIDTH)
+        {
+            page = i;
+            column_start = this->dirty_start[i];
+            column_end = this->dirty_end[i];
+
+            this->dirty_start[i] = SCREEN_WIDTH;
+            this->dirty_end[i] = 0u;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Write a span of columns within a single page to the display.
+ * Data in the framebuffer is sent without copying it, the byte in front of it is borrowed as headroom.
+ *
+ * @param page Page to write to.
+ * @param column_start First column to write.
+ * @param column_end Last column to write.
+ * @param data Data for columns column_start up to and including column_end.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_span(uint8_t page, uint8_t column_start, uint8_t column_end, const uint8_t* data)
+{
+    const std::less<const uint8_t*> before;
+
+    this->set_span_window(page, column_start, column_end);
+
+    /* The framebuffer always has a byte in front of it, framebuffer_memory[0] in front of the first byte. */
+    if (!before(data, this->framebuffer) && before(data, this->framebuffer + FRAMEBUFFER_SIZE))
+    {
+        this->write_data_in_place(this->framebuffer + (data - this->framebuffer), column_end - column_start + 1u);
+    }
+    else
+    {
+        this->write_data(data, column_end - column_start + 1u);
+    }
+}
+
+/**
+ * @brief Write all dirty spans of the framebuffer to the display.
+ * The spans are sent straight from the framebuffer, the byte in front of each span is borrowed as headroom.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::flush()
 {
-    uint8_t data[SCREEN_HEIGHT][SCREEN_WIDTH] = { 0u };
+    uint8_t page;
+    uint8_t column_start;
+    uint8_t column_end;
+
+    while (this->take_dirty_span(page, column_start, column_end))
+    {
+        this->set_span_window(page, column_start, column_end);
+        this->write_data_in_place(&this->framebuffer[page * SCREEN_WIDTH + column_start], column_end - column_start + 1u);
+    }
+}
+
+/**
+ * @brief Forget the shadowed controller state, so that all following commands are sent.
+ * Use this when the controller may have been changed or reset by something else.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::invalidate_shadow()
+{
+    this->shadow.fill(SHADOW_UNKNOWN);
+    this->scroll_setup.fill(0u);
+}
 
-    this->display(data);
+/**
+ * @brief Get the number of command bytes that were not sent because the controller already had the requested state.
+ *
+ * @return uint32_t Number of suppressed commands.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint32_t ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_suppressed_commands()
+{
+    return this->suppressed_commands;
 }
 
 /**
@@ -146,10 +597,19 @@ void ssd1306_t::clear_screen()
  *
  * @param contrast A value between 0-255 that indicates the screen contrast.
  */
-void ssd1306_t::set_contrast(uint8_t contrast)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_contrast(uint8_t contrast)
 {
+    if (this->is_shadowed(SHADOW_CONTRAST, contrast))
+    {
+        this->suppressed_commands += 2u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_CONTRAST_CONTROL);
     this->write_command(contrast);
+
+    this->shadow[SHADOW_CONTRAST] = contrast;
 }
 
 /**
@@ -157,7 +617,8 @@ void ssd1306_t::set_contrast(uint8_t contrast)
  *
  * @param state If true, uses GDDRAM contents. If false, doesn't use the GDDRAM contents.
  */
-void ssd1306_t::use_ram_contents(bool state)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::use_ram_contents(bool state)
 {
     this->write_command(COMMAND_ENTIRE_DISPLAY | !state);
 }
@@ -167,9 +628,18 @@ void ssd1306_t::use_ram_contents(bool state)
  *
  * @param state If true, inverts the GDDRAM contents before displaying. If false, uses normal display mode.
  */
-void ssd1306_t::set_inverse_display(bool state)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_inverse_display(bool state)
 {
+    if (this->is_shadowed(SHADOW_INVERSE, state))
+    {
+        this->suppressed_commands += 1u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_NORMAL_INVERTED_DISPLAY | state);
+
+    this->shadow[SHADOW_INVERSE] = state;
 }
 
 /**
@@ -177,7 +647,8 @@ void ssd1306_t::set_inverse_display(bool state)
  *
  * @param state If true, enables the display. If false, disables the display.
  */
-void ssd1306_t::enable_display(bool state)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::enable_display(bool state)
 {
     this->write_command(COMMAND_SET_DISPLAY | state);
 }
@@ -187,9 +658,18 @@ void ssd1306_t::enable_display(bool state)
  *
  * @param state If true, activates scrolling. If false, deactivates scrolling.
  */
-void ssd1306_t::activate_scroll(bool state)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::activate_scroll(bool state)
 {
+    if (this->is_shadowed(SHADOW_SCROLL_ACTIVE, state))
+    {
+        this->suppressed_commands += 1u;
+        return;
+    }
+
     this->write_command(state ? COMMAND_ACTIVATE_SCROLL : COMMAND_DEACTIVATE_SCROLL);
+
+    this->shadow[SHADOW_SCROLL_ACTIVE] = state;
 }
 
 /**
@@ -200,19 +680,22 @@ void ssd1306_t::activate_scroll(bool state)
  * @param interval Scrolling interval.
  * @param end_page Last page that is part of the scrolling.
  */
-void ssd1306_t::set_continuous_horizontal_scroll(continuous_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_continuous_horizontal_scroll(continuous_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page)
 {
     assert(start_page < NUMBER_OF_PAGES);
     assert(end_page < NUMBER_OF_PAGES);
     assert(start_page <= end_page);
 
-    this->write_command(COMMAND_CONTINUOUS_HORIZONTAL_SCROLL_SETUP | mode);
-    this->write_command(0x00u);
-    this->write_command(start_page);
-    this->write_command(interval);
-    this->write_command(end_page);
-    this->write_command(0x00u);
-    this->write_command(0xFFu);
+    this->write_scroll_setup({
+        (uint8_t)(COMMAND_CONTINUOUS_HORIZONTAL_SCROLL_SETUP | mode),
+        0x00u,
+        start_page,
+        interval,
+        end_page,
+        0x00u,
+        0xFFu
+    }, 7u);
 }
 
 /**
@@ -224,18 +707,21 @@ void ssd1306_t::set_continuous_horizontal_scroll(continuous_horizontal_scroll_mo
  * @param end_page Last page that is part of the scrolling.
  * @param offset Scrolling offset.
  */
-void ssd1306_t::set_continuous_vertical_horizontal_scroll(continuous_vertical_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page, uint8_t offset)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_continuous_vertical_horizontal_scroll(continuous_vertical_horizontal_scroll_mode mode, uint8_t start_page, continuous_horizontal_scroll_interval interval, uint8_t end_page, uint8_t offset)
 {
     assert(start_page < NUMBER_OF_PAGES);
     assert(end_page < NUMBER_OF_PAGES);
     assert(start_page <= end_page);
 
-    this->write_command(COMMAND_CONTINUOUS_VERTICAL_AND_HORIZONTAL_SCROLL_SETUP | mode);
-    this->write_command(0x00u);
-    this->write_command(start_page);
-    this->write_command(interval);
-    this->write_command(end_page);
-    this->write_command(offset);
+    this->write_scroll_setup({
+        (uint8_t)(COMMAND_CONTINUOUS_VERTICAL_AND_HORIZONTAL_SCROLL_SETUP | mode),
+        0x00u,
+        start_page,
+        interval,
+        end_page,
+        offset
+    }, 6u);
 }
 
 /**
@@ -244,12 +730,22 @@ void ssd1306_t::set_continuous_vertical_horizontal_scroll(continuous_vertical_ho
  * @param fixed_rows Amount of fixed rows.
  * @param scroll_rows Amound of scrolling rows.
  */
-void ssd1306_t::set_vertical_scroll_area(uint8_t fixed_rows, uint8_t scroll_rows)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_vertical_scroll_area(uint8_t fixed_rows, uint8_t scroll_rows)
 {
     // TODO: assert MUX ratio, Display Start Line
+    if (this->is_shadowed(SHADOW_SCROLL_FIXED_ROWS, fixed_rows) && this->is_shadowed(SHADOW_SCROLL_ROWS, scroll_rows))
+    {
+        this->suppressed_commands += 3u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_VERTICAL_SCROLL_AREA);
     this->write_command(fixed_rows);
     this->write_command(scroll_rows);
+
+    this->shadow[SHADOW_SCROLL_FIXED_ROWS] = fixed_rows;
+    this->shadow[SHADOW_SCROLL_ROWS] = scroll_rows;
 }
 
 /**
@@ -257,12 +753,16 @@ void ssd1306_t::set_vertical_scroll_area(uint8_t fixed_rows, uint8_t scroll_rows
  *
  * @param address Starting address.
  */
-void ssd1306_t::set_column_start_address(uint8_t address)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_column_start_address(uint8_t address)
 {
-    assert(address < SCREEN_WIDTH);
+    assert(address < GDDRAM_WIDTH);
 
     this->write_command(COMMAND_SET_LOWER_COLUMN_START_ADDRESS | (address & 0x0F));
     this->write_command(COMMAND_SET_HIGHER_COLUMN_START_ADDRESS | (address >> 4u));
+
+    /* The GDDRAM pointer is moved. */
+    this->invalidate_address_windows();
 }
 
 /**
@@ -270,10 +770,22 @@ void ssd1306_t::set_column_start_address(uint8_t address)
  *
  * @param mode
  */
-void ssd1306_t::set_memory_addressing_mode(addressing_mode mode)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_memory_addressing_mode(addressing_mode mode)
 {
+    if (this->is_shadowed(SHADOW_ADDRESSING_MODE, mode))
+    {
+        this->suppressed_commands += 2u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_MEMORY_ADDRESSING_MODE);
     this->write_command(mode);
+
+    this->shadow[SHADOW_ADDRESSING_MODE] = mode;
+
+    /* The pointer no longer wraps within the windows in page addressing mode. */
+    this->invalidate_address_windows();
 }
 
 /**
@@ -282,15 +794,26 @@ void ssd1306_t::set_memory_addressing_mode(addressing_mode mode)
  * @param start_address Column start address.
  * @param end_address Column end address.
  */
-void ssd1306_t::set_column_addresses(uint8_t start_address, uint8_t end_address)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_column_addresses(uint8_t start_address, uint8_t end_address)
 {
-    assert(start_address < SCREEN_WIDTH);
-    assert(end_address < SCREEN_WIDTH);
+    /* Addresses are GDDRAM columns, which are offset from the panel columns when the segments are remapped. */
+    assert(start_address < GDDRAM_WIDTH);
+    assert(end_address < GDDRAM_WIDTH);
     assert(start_address <= end_address);
 
+    if (this->is_shadowed(SHADOW_COLUMN_START, start_address) && this->is_shadowed(SHADOW_COLUMN_END, end_address))
+    {
+        this->suppressed_commands += 3u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_COLUMN_ADDRESS);
     this->write_command(start_address);
     this->write_command(end_address);
+
+    this->shadow[SHADOW_COLUMN_START] = start_address;
+    this->shadow[SHADOW_COLUMN_END] = end_address;
 }
 
 /**
@@ -299,15 +822,25 @@ void ssd1306_t::set_column_addresses(uint8_t start_address, uint8_t end_address)
  * @param start_address Page start address.
  * @param end_address Page end address.
  */
-void ssd1306_t::set_page_addresses(uint8_t start_address, uint8_t end_address)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_page_addresses(uint8_t start_address, uint8_t end_address)
 {
     assert(start_address < NUMBER_OF_PAGES);
     assert(end_address < NUMBER_OF_PAGES);
     assert(start_address <= end_address);
 
+    if (this->is_shadowed(SHADOW_PAGE_START, start_address) && this->is_shadowed(SHADOW_PAGE_END, end_address))
+    {
+        this->suppressed_commands += 3u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_PAGE_ADDRESS);
     this->write_command(start_address);
     this->write_command(end_address);
+
+    this->shadow[SHADOW_PAGE_START] = start_address;
+    this->shadow[SHADOW_PAGE_END] = end_address;
 }
 
 /**
@@ -315,11 +848,15 @@ void ssd1306_t::set_page_addresses(uint8_t start_address, uint8_t end_address)
  *
  * @param address Page start address.
  */
-void ssd1306_t::set_page_start_address(uint8_t address)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_page_start_address(uint8_t address)
 {
     assert(address < NUMBER_OF_PAGES);
 
     this->write_command(COMMAND_SET_PAGE_START_ADDRESS | address);
+
+    /* The GDDRAM pointer is moved. */
+    this->invalidate_address_windows();
 }
 
 /**
@@ -327,11 +864,20 @@ void ssd1306_t::set_page_start_address(uint8_t address)
  *
  * @param line Line to start displaying at.
  */
-void ssd1306_t::set_display_start_line(uint8_t line)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_display_start_line(uint8_t line)
 {
     assert(line < SCREEN_HEIGHT);
 
+    if (this->is_shadowed(SHADOW_START_LINE, line))
+    {
+        this->suppressed_commands += 1u;
+        return;
+    }
+
     this->write_command(COMMAND_SET_DISPLAY_START_LINE | line);
+
+    this->shadow[SHADOW_START_LINE] = line;
 }
 
 /**
@@ -339,8 +885,12 @@ void ssd1306_t::set_display_start_line(uint8_t line)
  *
  * @param mode When true, the segments are reversed. When false, the segments use their normal mapping.
  */
-void ssd1306_t::set_segmet_re_map(re_map_mode mode)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_segmet_re_map(re_map_mode mode)
 {
+    /* Column 127 drives SEG0, so a narrower panel starts at a higher column. */
+    this->column_offset = mode == RE_MAP_MODE_127 ? GDDRAM_WIDTH - SCREEN_WIDTH : 0u;
+
     this->write_command(COMMAND_SET_SEGMENT_RE_MAP | mode);
 }
 
@@ -349,7 +899,8 @@ void ssd1306_t::set_segmet_re_map(re_map_mode mode)
  *
  * @param ratio Multiplex ratio to set. Must be between 16-64
  */
-void ssd1306_t::set_multiplex_ratio(uint8_t ratio)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_multiplex_ratio(uint8_t ratio)
 {
     assert(16u <= ratio && ratio <= 64u);
 
@@ -362,7 +913,8 @@ void ssd1306_t::set_multiplex_ratio(uint8_t ratio)
  *
  * @param mode Mode to use. Can be normal (from top to bottom) or re-mapped (from bottom to top).
  */
-void ssd1306_t::set_com_output_scan_direction(com_output_scan_direction mode)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_com_output_scan_direction(com_output_scan_direction mode)
 {
     this->write_command(COMMAND_SET_COM_OUTPUT_SCAN_DIRECTION | mode);
 }
@@ -372,7 +924,8 @@ void ssd1306_t::set_com_output_scan_direction(com_output_scan_direction mode)
  *
  * @param offset Offset to set.
  */
-void ssd1306_t::set_display_offset(uint8_t offset)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_display_offset(uint8_t offset)
 {
     assert(offset < SCREEN_HEIGHT);
 
@@ -386,10 +939,11 @@ void ssd1306_t::set_display_offset(uint8_t offset)
  * @param configuration Sequential or alternative configuration.
  * @param enable_remap When true, re-mapping of rows is enabled. When false, rows are not re-mapped.
  */
-void ssd1306_t::set_com_pins_hardware_configuration(com_pins_hardware_configuration configuration, bool enable_remap)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_com_pins_hardware_configuration(com_pins_hardware_configuration configuration, bool enable_remap)
 {
     this->write_command(COMMAND_SET_COM_PINS_HARDWARE_CONFIGURATION);
-    this->write_command(0x02u | (configuration << 5u) | (enable_remap << 4u));
+    this->write_command(0x02u | (configuration << 4u) | (enable_remap << 5u));
 }
 
 /**
@@ -398,7 +952,8 @@ void ssd1306_t::set_com_pins_hardware_configuration(com_pins_hardware_configurat
  * @param clock_divider Clock divider for the oscillator clock. Must be between 1 and 16.
  * @param oscillator_frequency Frequency used for the oscillator between 333 and 407 kHz.
  */
-void ssd1306_t::set_display_clock(uint8_t clock_divider, uint8_t oscillator_frequency)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_display_clock(uint8_t clock_divider, uint8_t oscillator_frequency)
 {
     assert(1u <= clock_divider && clock_divider <= 0b1111u + 1u);
     assert(oscillator_frequency <= 0b1111u);
@@ -413,7 +968,8 @@ void ssd1306_t::set_display_clock(uint8_t clock_divider, uint8_t oscillator_freq
  * @param phase_1_period Phase 1 discharging period.
  * @param phase_2_period Phase 2 charging period.
  */
-void ssd1306_t::set_pre_charge_period(uint8_t phase_1_period, uint8_t phase_2_period)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_pre_charge_period(uint8_t phase_1_period, uint8_t phase_2_period)
 {
     assert(1u <= phase_1_period && phase_1_period <= 0b1111u);
     assert(1u <= phase_2_period && phase_2_period <= 0b1111u);
@@ -427,7 +983,8 @@ void ssd1306_t::set_pre_charge_period(uint8_t phase_1_period, uint8_t phase_2_pe
  *
  * @param level Voltage level.
  */
-void ssd1306_t::set_v_comh_deselect_level(v_comh_deselect_level level)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_v_comh_deselect_level(v_comh_deselect_level level)
 {
     this->write_command(COMMAND_SET_V_COMH_DESELECT_LEVEL);
     this->write_command(level << 4u);
@@ -436,7 +993,8 @@ void ssd1306_t::set_v_comh_deselect_level(v_comh_deselect_level level)
 /**
  * @brief No Operation command.
  */
-void ssd1306_t::nop()
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::nop()
 {
     this->write_command(COMMAND_NOP);
 }
@@ -446,7 +1004,8 @@ void ssd1306_t::nop()
  *
  * @param state If true, charge pump regulator is enabled. If false, it is disabled.
  */
-void ssd1306_t::enable_charge_pump(bool state)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::enable_charge_pump(bool state)
 {
     this->write_command(COMMAND_CHARGE_PUMP_SETTING);
     this->write_command(0b010000 | (state << 2u));
@@ -457,11 +1016,10 @@ void ssd1306_t::enable_charge_pump(bool state)
  *
  * @param command Command to write.
  */
-void ssd1306_t::write_command(uint8_t command)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_command(uint8_t command)
 {
-    uint8_t buffer[2] = { COMMAND_BYTE, command };
-
-    this->i2c_write(buffer, 2);
+    this->transport.write_commands(&command, 1u);
 }
 
 /**
@@ -469,15 +1027,13 @@ void ssd1306_t::write_command(uint8_t command)
  *
  * @return uint8_t Display status. 1u is on, 0u is off.
  */
-uint8_t ssd1306_t::get_display_status()
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t ssd1306_t<WIDTH, HEIGHT, COM_PINS>::get_display_status()
 {
-    uint8_t result;
-    uint8_t command[1] = { COMMAND_BYTE };
-
-    this->i2c_write(command, 1u);
-    this->i2c_read(&result, 1u);
+    const uint8_t result = this->transport.read_status();
 
-    return result >> 6u;
+    /* D6 of the status register is set when the display is off. */
+    return ((result >> 6u) & 1u) ^ 1u;
 }
 
 /**
@@ -485,11 +1041,41 @@ uint8_t ssd1306_t::get_display_status()
  *
  * @param data Data byte to write.
  */
-void ssd1306_t::write_data(uint8_t data)
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_data(uint8_t data)
+{
+    this->transport.write_data(&data, 1u);
+
+    /* A single byte does not fill the window, so the GDDRAM pointer is not at the start of it anymore. */
+    this->invalidate_address_windows();
+}
+
+/**
+ * @brief Writes a sequence of data bytes to the display.
+ *
+ * @param data Data bytes to write.
+ * @param size Number of data bytes to write.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_data(const uint8_t* data, uint16_t size)
 {
-    uint8_t buffer[2] = { DATA_BYTE, data };
+    assert(size <= FRAMEBUFFER_SIZE);
 
-    this->i2c_write(buffer, 2u);
+    this->transport.write_data(data, size);
+}
+
+/**
+ * @brief Writes a sequence of data bytes to the display without copying them.
+ *
+ * @param data Data bytes to write, with a byte of writable headroom in front. The headroom is restored afterwards.
+ * @param size Number of data bytes to write.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_data_in_place(uint8_t* data, uint16_t size)
+{
+    assert(size <= FRAMEBUFFER_SIZE);
+
+    this->transport.write_data_in_place(data, size);
 }
 
 /**
@@ -497,14 +1083,84 @@ void ssd1306_t::write_data(uint8_t data)
  *
  * @return uint8_t Data that was read.
  */
-uint8_t ssd1306_t::read_data()
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+uint8_t ssd1306_t<WIDTH, HEIGHT, COM_PINS>::read_data()
 {
-    uint8_t data[1] = { DATA_BYTE };
+    const uint8_t data = this->transport.read_data();
 
-    this->i2c_write(data, 1u);
-    /* Dummy read. */
-    this->i2c_read(data, 1u);
-    this->i2c_read(data, 1u);
+    /* Reading moves the GDDRAM pointer. */
+    this->invalidate_address_windows();
+
+    return data;
+}
+
+/**
+ * @brief Set the address window to a span of columns within a single page.
+ *
+ * @param page Page of the span.
+ * @param column_start First column of the span.
+ * @param column_end Last column of the span.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::set_span_window(uint8_t page, uint8_t column_start, uint8_t column_end)
+{
+    this->set_memory_addressing_mode(HORIZONTAL_ADDRESSING_MODE);
+    this->set_page_addresses(page, page);
+    this->set_column_addresses(this->column_offset + column_start, this->column_offset + column_end);
+}
 
-    return *data;
+/**
+ * @brief Check whether a shadowed register is known to have a value.
+ *
+ * @param reg Shadowed register.
+ * @param value Value to compare to.
+ * @return true if the register has the value, false if it differs or is unknown.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+bool ssd1306_t<WIDTH, HEIGHT, COM_PINS>::is_shadowed(shadow_register reg, uint8_t value)
+{
+    return this->shadow[reg] == value;
 }
+
+/**
+ * @brief Forget the shadowed address windows, so that they are sent before the next data write.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+void ssd1306_t<WIDTH, HEIGHT, COM_PINS>::invalidate_address_windows()
+{
+    this->shadow[SHADOW_PAGE_START] = SHADOW_UNKNOWN;
+    this->shadow[SHADOW_PAGE_END] = SHADOW_UNKNOWN;
+    this->shadow[SHADOW_COLUMN_START] = SHADOW_UNKNOWN;
+    this->shadow[SHADOW_COLUMN_END] = SHADOW_UNKNOWN;
+}
+
+/**
+ * @brief Write a scroll setup command, unless it is the same as the last one.
+ *
+ * @param setup Command bytes of the scroll setup.
+ * @param size Number of command bytes used.
+ * @return true if the command was written.
+ */
+template <uint8_t WIDTH, uint8_t HEIGHT, ssd1306_com_pins_configuration COM_PINS>
+bool ssd1306_t<WIDTH, HEIGHT, COM_PINS>::write_scroll_setup(const std::array<uint8_t, SCROLL_SETUP_SIZE>& setup, uint8_t size)
+{
+    if (this->scroll_setup == setup)
+    {
+        this->suppressed_commands += size;
+        return false;
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        this->write_command(setup[i]);
+    }
+
+    this->scroll_setup = setup;
+
+    return true;
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_t<128u, 32u, COM_PINS_HARDWARE_SEQUENTIAL>;
+template class pi_zero_peripherals::ssd1306_t<128u, 64u, COM_PINS_HARDWARE_ALTERNATIVE>;
+template class pi_zero_peripherals::ssd1306_t<96u, 16u, COM_PINS_HARDWARE_SEQUENTIAL>;
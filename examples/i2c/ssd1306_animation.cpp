@@ -0,0 +1,513 @@
+/**
+ * @file ssd1306_animation.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Compact animation files for SSD1306 panels and a player that streams them to a display.
+ * @date 18-10-2026
+ *
+ * An animation file starts with a 16 byte header (multi-byte values are little-endian):
+ * - magic "SSDA", version (1), width, height, flags,
+ * - default frame rate (2 bytes), reserved (2 bytes), number of frames (4 bytes).
+ *
+ * Each frame only contains the page-major framebuffer bytes that changed since the previous frame
+ * (the first frame is relative to a blank screen). A frame is a 2 byte span count, followed by the spans.
+ * A span is <page, first column, length>, followed by the run-length encoded bytes of the span:
+ * - control byte 0b1nnnnnnn: the next byte is repeated n + 1 times,
+ * - control byte 0b0nnnnnnn: the next n + 1 bytes are literal.
+ *
+ * If ANIMATION_FLAG_LOOP_FRAME is set, an extra frame follows the last frame, which changes the last frame
+ * back into the first frame. This way a looping animation never needs to redraw the whole screen.
+ */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "include/ssd1306_animation.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Unchanged bytes between two changes that are still sent as part of one span, instead of starting a new span. */
+static constexpr uint8_t SPAN_MERGE_GAP = 3u;
+/* Maximum length of a single run in the run-length encoding. */
+static constexpr uint8_t MAX_RUN_LENGTH = 128u;
+/* Minimum length of a repeated run, shorter runs are stored as literals. */
+static constexpr uint8_t MIN_REPEAT_LENGTH = 3u;
+static constexpr uint8_t REPEAT_RUN = 0x80u;
+
+/**
+ * @brief Construct a new ssd1306_animation_exception object. Used when an animation file is invalid or cannot be accessed.
+ *
+ * @param message Error message.
+ */
+ssd1306_animation_exception::ssd1306_animation_exception(const std::string& message) :
+    runtime_error(message)
+{}
+
+/**
+ * @brief Construct a new ssd1306_animation_writer_t object.
+ *
+ * @param width Width of the frames in pixels.
+ * @param height Height of the frames in pixels. Must be a multiple of 8.
+ * @param frame_rate Default frame rate of the animation.
+ */
+ssd1306_animation_writer_t::ssd1306_animation_writer_t(uint8_t width, uint8_t height, uint16_t frame_rate) :
+    width(width),
+    height(height),
+    frame_rate(frame_rate),
+    frame_count(0u),
+    first_frame(width * (height / 8u), 0u),
+    previous_frame(width * (height / 8u), 0u)
+{
+    assert(width > 0u && width <= 128u);
+    assert(height > 0u && height <= 64u && height % 8u == 0u);
+}
+
+/**
+ * @brief Add a frame to the animation.
+ *
+ * @param framebuffer Page-major frame of width * height / 8 bytes.
+ */
+void ssd1306_animation_writer_t::add_frame(const uint8_t* framebuffer)
+{
+    this->encode_frame(this->previous_frame.data(), framebuffer, this->frames);
+
+    memcpy(this->previous_frame.data(), framebuffer, this->previous_frame.size());
+
+    if (this->frame_count == 0u)
+    {
+        memcpy(this->first_frame.data(), framebuffer, this->first_frame.size());
+    }
+
+    this->frame_count++;
+}
+
+/**
+ * @brief Write the animation to a file.
+ *
+ * @param file_name Name of the file.
+ * @param loop If true, a loop frame is added so the animation can loop without redrawing the screen.
+ */
+void ssd1306_animation_writer_t::save(const std::string& file_name, bool loop)
+{
+    std::vector<uint8_t> loop_frame;
+    uint8_t header[ANIMATION_HEADER_SIZE] = {
+        ANIMATION_MAGIC[0], ANIMATION_MAGIC[1], ANIMATION_MAGIC[2], ANIMATION_MAGIC[3],
+        ANIMATION_VERSION,
+        this->width,
+        this->height,
+        loop ? ANIMATION_FLAG_LOOP_FRAME : (uint8_t)0u,
+        (uint8_t)(this->frame_rate & 0xFFu), (uint8_t)(this->frame_rate >> 8u),
+        0u, 0u,
+        (uint8_t)(this->frame_count & 0xFFu), (uint8_t)(this->frame_count >> 8u),
+        (uint8_t)(this->frame_count >> 16u), (uint8_t)(this->frame_count >> 24u)
+    };
+
+    if (loop)
+    {
+        this->encode_frame(this->previous_frame.data(), this->first_frame.data(), loop_frame);
+    }
+
+    FILE* file = fopen(file_name.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        throw ssd1306_animation_exception("could not create animation file " + file_name);
+    }
+
+    /* Empty vectors can have a null data(), which must not be passed to fwrite. */
+    const bool written = fwrite(header, 1u, sizeof(header), file) == sizeof(header) &&
+                         (this->frames.empty() || fwrite(this->frames.data(), 1u, this->frames.size(), file) == this->frames.size()) &&
+                         (loop_frame.empty() || fwrite(loop_frame.data(), 1u, loop_frame.size(), file) == loop_frame.size());
+
+    if (fclose(file) != 0 || !written)
+    {
+        throw ssd1306_animation_exception("could not write animation file " + file_name);
+    }
+}
+
+/**
+ * @brief Encode the difference between two frames.
+ *
+ * @param previous Previous frame.
+ * @param current Current frame.
+ * @param output Vector to append the encoded frame to.
+ */
+void ssd1306_animation_writer_t::encode_frame(const uint8_t* previous, const uint8_t* current, std::vector<uint8_t>& output)
+{
+    const size_t span_count_offset = output.size();
+    uint16_t span_count = 0u;
+
+    /* Placeholder for the span count. */
+    output.push_back(0u);
+    output.push_back(0u);
+
+    for (size_t page = 0; page < this->height / 8u; page++)
+    {
+        const uint8_t* old_page = previous + page * this->width;
+        const uint8_t* new_page = current + page * this->width;
+        size_t column = 0;
+
+        while (column < this->width)
+        {
+            if (old_page[column] == new_page[column])
+            {
+                column++;
+                continue;
+            }
+
+            /* Extend the span while the next change is close enough. */
+            size_t start = column;
+            size_t end = column;
+
+            for (size_t next = column + 1u; next < this->width && next <= end + SPAN_MERGE_GAP + 1u; next++)
+            {
+                if (old_page[next] != new_page[next])
+                {
+                    end = next;
+                }
+            }
+
+            output.push_back(page);
+            output.push_back(start);
+            output.push_back(end - start + 1u);
+
+            /* Run-length encode the bytes of the span. */
+            size_t i = start;
+
+            while (i <= end)
+            {
+                size_t run = 1u;
+
+                while (i + run <= end && run < MAX_RUN_LENGTH && new_page[i + run] == new_page[i])
+                {
+                    run++;
+                }
+
+                if (run >= MIN_REPEAT_LENGTH)
+                {
+                    output.push_back(REPEAT_RUN | (run - 1u));
+                    output.push_back(new_page[i]);
+                    i += run;
+                    continue;
+                }
+
+                /* Collect literals until a repeated run starts. */
+                size_t literal = 0u;
+
+                while (i + literal <= end && literal < MAX_RUN_LENGTH)
+                {
+                    if (i + literal + MIN_REPEAT_LENGTH - 1u <= end &&
+                        new_page[i + literal] == new_page[i + literal + 1u] &&
+                        new_page[i + literal] == new_page[i + literal + 2u])
+                    {
+                        break;
+                    }
+
+                    literal++;
+                }
+
+                output.push_back(literal - 1u);
+                output.insert(output.end(), new_page + i, new_page + i + literal);
+                i += literal;
+            }
+
+            span_count++;
+            column = end + 1u;
+        }
+    }
+
+    output[span_count_offset] = span_count & 0xFFu;
+    output[span_count_offset + 1u] = span_count >> 8u;
+}
+
+/**
+ * @brief Construct a new ssd1306_animation_t object.
+ *
+ * @param display Display to play the animation on.
+ */
+template <typename DISPLAY>
+ssd1306_animation_t<DISPLAY>::ssd1306_animation_t(DISPLAY& display) :
+    display(display),
+    data(nullptr),
+    size(0u),
+    offset(0u),
+    second_frame_offset(0u),
+    frame_index(0u)
+{}
+
+/**
+ * @brief Destroy the ssd1306_animation_t object. Unmaps the animation file.
+ */
+template <typename DISPLAY>
+ssd1306_animation_t<DISPLAY>::~ssd1306_animation_t()
+{
+    this->close();
+}
+
+/**
+ * @brief Memory-map an animation file and check that it matches the display.
+ *
+ * @param file_name Name of the animation file.
+ */
+template <typename DISPLAY>
+void ssd1306_animation_t<DISPLAY>::open(const std::string& file_name)
+{
+    struct stat file_status;
+
+    this->close();
+
+    const int fd = ::open(file_name.c_str(), O_RDONLY);
+
+    if (fd == -1)
+    {
+        throw ssd1306_animation_exception("could not open animation file " + file_name);
+    }
+
+    if (fstat(fd, &file_status) == -1 || file_status.st_size < ANIMATION_HEADER_SIZE)
+    {
+        ::close(fd);
+        throw ssd1306_animation_exception("animation file " + file_name + " is too small");
+    }
+
+    void* mapping = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping stays valid after closing the file. */
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        throw ssd1306_animation_exception("could not map animation file " + file_name);
+    }
+
+    /* Frames are read front to back. */
+    madvise(mapping, file_status.st_size, MADV_SEQUENTIAL);
+
+    this->data = static_cast<const uint8_t*>(mapping);
+    this->size = file_status.st_size;
+
+    if (memcmp(this->data, ANIMATION_MAGIC, sizeof(ANIMATION_MAGIC)) != 0 || this->data[4] != ANIMATION_VERSION)
+    {
+        this->close();
+        throw ssd1306_animation_exception(file_name + " is not an animation file");
+    }
+
+    if (this->data[5] != DISPLAY::SCREEN_WIDTH || this->data[6] != DISPLAY::SCREEN_HEIGHT)
+    {
+        this->close();
+        throw ssd1306_animation_exception("geometry of " + file_name + " does not match the display");
+    }
+
+    this->rewind();
+}
+
+/**
+ * @brief Unmap the animation file, if any.
+ */
+template <typename DISPLAY>
+void ssd1306_animation_t<DISPLAY>::close()
+{
+    if (this->data != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(this->data), this->size);
+        this->data = nullptr;
+        this->size = 0u;
+    }
+}
+
+/**
+ * @brief Continue playing from the first frame.
+ */
+template <typename DISPLAY>
+void ssd1306_animation_t<DISPLAY>::rewind()
+{
+    this->offset = ANIMATION_HEADER_SIZE;
+    this->frame_index = 0u;
+}
+
+/**
+ * @brief Show the next frame of the animation.
+ * The first frame is written completely, later frames only write the spans that changed.
+ * The framebuffer of the display must not be changed by others while playing.
+ *
+ * @param loop If true, the first frame follows the last frame.
+ * @return true if a frame was shown, false if the end of the animation was reached or the animation has no frames.
+ */
+template <typename DISPLAY>
+bool ssd1306_animation_t<DISPLAY>::next_frame(bool loop)
+{
+    assert(this->data != nullptr);
+
+    if (this->frame_index == this->get_frame_count())
+    {
+        /* An animation without frames has nothing to loop to. */
+        if (!loop || this->get_frame_count() == 0u)
+        {
+            return false;
+        }
+
+        if (this->data[7] & ANIMATION_FLAG_LOOP_FRAME)
+        {
+            /* The loop frame turns the last frame into the first frame, continue with the second frame. */
+            this->decode_frame();
+            this->offset = this->second_frame_offset;
+            this->frame_index = 1u;
+
+            return true;
+        }
+
+        this->rewind();
+    }
+
+    if (this->frame_index == 0u)
+    {
+        /* The first frame is relative to a blank screen and written as a whole. */
+        memset(this->display.get_framebuffer(), 0u, DISPLAY::FRAMEBUFFER_SIZE);
+        this->decode_frame();
+        this->display.display_framebuffer();
+        this->second_frame_offset = this->offset;
+    }
+    else
+    {
+        this->decode_frame();
+    }
+
+    this->frame_index++;
+
+    return true;
+}
+
+/**
+ * @brief Play the animation at a fixed frame rate. Blocks until the animation ends.
+ *
+ * @param frame_rate Frames per second. If 0, the frame rate stored in the file is used.
+ * @param loop If true, the animation loops forever.
+ */
+template <typename DISPLAY>
+void ssd1306_animation_t<DISPLAY>::play(uint16_t frame_rate, bool loop)
+{
+    if (frame_rate == 0u)
+    {
+        frame_rate = this->get_frame_rate();
+    }
+
+    assert(frame_rate > 0u);
+
+    const std::chrono::nanoseconds period(1000000000u / frame_rate);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now();
+
+    while (this->next_frame(loop))
+    {
+        deadline += period;
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+/**
+ * @brief Get the number of frames in the animation.
+ *
+ * @return uint32_t Number of frames, not counting the loop frame.
+ */
+template <typename DISPLAY>
+uint32_t ssd1306_animation_t<DISPLAY>::get_frame_count()
+{
+    assert(this->data != nullptr);
+
+    return this->data[12] | (this->data[13] << 8u) | (this->data[14] << 16u) | ((uint32_t)this->data[15] << 24u);
+}
+
+/**
+ * @brief Get the default frame rate of the animation.
+ *
+ * @return uint16_t Frames per second.
+ */
+template <typename DISPLAY>
+uint16_t ssd1306_animation_t<DISPLAY>::get_frame_rate()
+{
+    assert(this->data != nullptr);
+
+    return this->data[8] | (this->data[9] << 8u);
+}
+
+/**
+ * @brief Decode the frame at the current offset into the framebuffer of the display.
+ * Except for the first frame, every span is written to the display as soon as it is decoded.
+ */
+template <typename DISPLAY>
+void ssd1306_animation_t<DISPLAY>::decode_frame()
+{
+    uint8_t* framebuffer = this->display.get_framebuffer();
+    const bool write = this->frame_index != 0u;
+
+    if (this->offset + 2u > this->size)
+    {
+        throw ssd1306_animation_exception("animation file is truncated");
+    }
+
+    const uint16_t span_count = this->data[this->offset] | (this->data[this->offset + 1u] << 8u);
+    this->offset += 2u;
+
+    for (size_t span = 0; span < span_count; span++)
+    {
+        if (this->offset + 3u > this->size)
+        {
+            throw ssd1306_animation_exception("animation file is truncated");
+        }
+
+        const uint8_t page = this->data[this->offset];
+        const uint8_t column = this->data[this->offset + 1u];
+        const uint8_t length = this->data[this->offset + 2u];
+        this->offset += 3u;
+
+        if (page >= DISPLAY::NUMBER_OF_PAGES || length == 0u || column + length > DISPLAY::SCREEN_WIDTH)
+        {
+            throw ssd1306_animation_exception("animation file contains an invalid span");
+        }
+
+        uint8_t* destination = framebuffer + page * DISPLAY::SCREEN_WIDTH + column;
+        size_t decoded = 0u;
+
+        while (decoded < length)
+        {
+            if (this->offset + 2u > this->size)
+            {
+                throw ssd1306_animation_exception("animation file is truncated");
+            }
+
+            const uint8_t control = this->data[this->offset++];
+            const size_t run = (control & ~REPEAT_RUN) + 1u;
+
+            if (decoded + run > length || (!(control & REPEAT_RUN) && this->offset + run > this->size))
+            {
+                throw ssd1306_animation_exception("animation file contains an invalid run");
+            }
+
+            if (control & REPEAT_RUN)
+            {
+                memset(destination + decoded, this->data[this->offset], run);
+                this->offset += 1u;
+            }
+            else
+            {
+                memcpy(destination + decoded, this->data + this->offset, run);
+                this->offset += run;
+            }
+
+            decoded += run;
+        }
+
+        if (write)
+        {
+            this->display.write_span(page, column, column + length - 1u, destination);
+        }
+    }
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_animation_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_animation_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_animation_t<ssd1306_96x16_t>;
@@ -0,0 +1,325 @@
+/**
+ * @file ssd1306_compositor.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Layered compositor on top of the framebuffer of ssd1306_t.
+ * @date 18-10-2026
+ *
+ * Every layer has its own page-major pixels (and a mask for BLEND_MASKED). Changes to a layer are reported as
+ * damage in layer coordinates, which is translated to the screen and merged into one column span per page,
+ * the same granularity as the dirty spans of ssd1306_t. Moving, hiding and restacking a layer damages the area
+ * it covered and the area it covers now.
+ *
+ * compose() recomputes the damaged spans from bottom to top, starting at the topmost opaque layer that covers
+ * the whole span, because nothing below it can be seen. Only the columns of which the result differs from the
+ * framebuffer are marked dirty, so an update that is hidden by another layer (e.g. a clock under a popup)
+ * does not cost any bus traffic at all.
+ */
+
+#include <algorithm>
+#include <assert.h>
+
+#include "include/ssd1306_compositor.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new ssd1306_compositor_t object without layers.
+ *
+ * @param display Display to composite on.
+ */
+template <typename DISPLAY>
+ssd1306_compositor_t<DISPLAY>::ssd1306_compositor_t(DISPLAY& display) :
+    display(display)
+{
+    std::fill_n(this->damage_start, DISPLAY::NUMBER_OF_PAGES, DISPLAY::SCREEN_WIDTH);
+    std::fill_n(this->damage_end, DISPLAY::NUMBER_OF_PAGES, 0u);
+}
+
+/**
+ * @brief Add a layer. It starts empty (all pixels off, nothing masked in) and visible.
+ *
+ * @param x First column of the layer.
+ * @param page First page of the layer.
+ * @param width Width of the layer in columns.
+ * @param pages Height of the layer in pages.
+ * @param z Stacking order, higher is on top. Layers with the same z are stacked in the order they were added.
+ * @param blend How the layer is combined with the layers below it.
+ * @return uint8_t Index of the layer.
+ */
+template <typename DISPLAY>
+uint8_t ssd1306_compositor_t<DISPLAY>::add_layer(uint8_t x, uint8_t page, uint8_t width, uint8_t pages, uint8_t z, blend_mode blend)
+{
+    assert(width > 0u && x + width <= DISPLAY::SCREEN_WIDTH);
+    assert(pages > 0u && page + pages <= DISPLAY::NUMBER_OF_PAGES);
+
+    this->layers.push_back({ x, page, width, pages, z, blend, true,
+                             std::vector<uint8_t>(width * pages, 0u), std::vector<uint8_t>(width * pages, 0u) });
+    this->damage(this->layers.size() - 1u);
+
+    return this->layers.size() - 1u;
+}
+
+/**
+ * @brief Get the pixels of a layer: page-major, with rows of the width of the layer.
+ *
+ * @param layer Index of the layer.
+ * @return uint8_t* Pixels of the layer.
+ */
+template <typename DISPLAY>
+uint8_t* ssd1306_compositor_t<DISPLAY>::get_pixels(uint8_t layer)
+{
+    return this->layers[layer].pixels.data();
+}
+
+/**
+ * @brief Get the mask of a layer, only used with BLEND_MASKED. Same layout as the pixels.
+ *
+ * @param layer Index of the layer.
+ * @return uint8_t* Mask of the layer.
+ */
+template <typename DISPLAY>
+uint8_t* ssd1306_compositor_t<DISPLAY>::get_mask(uint8_t layer)
+{
+    return this->layers[layer].mask.data();
+}
+
+/**
+ * @brief Report that the whole layer changed.
+ *
+ * @param layer Index of the layer.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::damage(uint8_t layer)
+{
+    const layer_t& l = this->layers[layer];
+
+    this->damage_screen(l.x, l.page, l.x + l.width - 1u, l.page + l.pages - 1u);
+}
+
+/**
+ * @brief Report that a rectangle of a layer changed.
+ *
+ * @param layer Index of the layer.
+ * @param column_start First changed column, relative to the layer.
+ * @param page_start First changed page, relative to the layer.
+ * @param column_end Last changed column, relative to the layer.
+ * @param page_end Last changed page, relative to the layer.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::damage(uint8_t layer, uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end)
+{
+    const layer_t& l = this->layers[layer];
+
+    assert(column_start <= column_end && column_end < l.width);
+    assert(page_start <= page_end && page_end < l.pages);
+
+    this->damage_screen(l.x + column_start, l.page + page_start, l.x + column_end, l.page + page_end);
+}
+
+/**
+ * @brief Move a layer to another position.
+ *
+ * @param layer Index of the layer.
+ * @param x New first column.
+ * @param page New first page.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::move_layer(uint8_t layer, uint8_t x, uint8_t page)
+{
+    layer_t& l = this->layers[layer];
+
+    assert(x + l.width <= DISPLAY::SCREEN_WIDTH);
+    assert(page + l.pages <= DISPLAY::NUMBER_OF_PAGES);
+
+    this->damage(layer);
+    l.x = x;
+    l.page = page;
+    this->damage(layer);
+}
+
+/**
+ * @brief Show or hide a layer.
+ *
+ * @param layer Index of the layer.
+ * @param visible True to show the layer.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::set_visible(uint8_t layer, bool visible)
+{
+    if (this->layers[layer].visible != visible)
+    {
+        this->layers[layer].visible = visible;
+        this->damage(layer);
+    }
+}
+
+/**
+ * @brief Change the stacking order of a layer.
+ *
+ * @param layer Index of the layer.
+ * @param z New stacking order, higher is on top.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::set_z(uint8_t layer, uint8_t z)
+{
+    if (this->layers[layer].z != z)
+    {
+        this->layers[layer].z = z;
+        this->damage(layer);
+    }
+}
+
+/**
+ * @brief Composite the damaged spans into the framebuffer and write the columns that changed.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::compose()
+{
+    uint8_t* framebuffer = this->display.get_framebuffer();
+    std::vector<uint8_t> order;
+    std::vector<uint8_t> stack;
+    bool damaged = false;
+
+    /* Visible layers from bottom to top. */
+    for (size_t i = 0; i < this->layers.size(); i++)
+    {
+        if (this->layers[i].visible)
+        {
+            order.push_back(i);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](uint8_t a, uint8_t b) { return this->layers[a].z < this->layers[b].z; });
+
+    for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+    {
+        const uint8_t column_start = this->damage_start[page];
+        const uint8_t column_end = this->damage_end[page];
+        uint8_t changed_start = DISPLAY::SCREEN_WIDTH;
+        uint8_t changed_end = 0u;
+
+        if (column_start > column_end)
+        {
+            continue;
+        }
+
+        /* Layers that overlap the span, bottom to top. */
+        stack.clear();
+
+        for (const uint8_t i : order)
+        {
+            const layer_t& l = this->layers[i];
+
+            if (l.page <= page && page < l.page + l.pages && l.x <= column_end && column_start < l.x + l.width)
+            {
+                stack.push_back(i);
+            }
+        }
+
+        /* Skip everything below the topmost opaque layer that covers the whole span. */
+        size_t bottom = 0u;
+
+        for (size_t i = stack.size(); i > 0u; i--)
+        {
+            const layer_t& l = this->layers[stack[i - 1u]];
+
+            if (l.blend == BLEND_OPAQUE && l.x <= column_start && column_end < l.x + l.width)
+            {
+                bottom = i - 1u;
+                break;
+            }
+        }
+
+        for (size_t column = column_start; column <= column_end; column++)
+        {
+            uint8_t value = 0u;
+
+            for (size_t i = bottom; i < stack.size(); i++)
+            {
+                const layer_t& l = this->layers[stack[i]];
+
+                if (column < l.x || column >= l.x + l.width)
+                {
+                    continue;
+                }
+
+                const size_t index = (page - l.page) * l.width + column - l.x;
+
+                switch (l.blend)
+                {
+                case BLEND_OPAQUE:
+                    value = l.pixels[index];
+                    break;
+                case BLEND_TRANSPARENT:
+                    value |= l.pixels[index];
+                    break;
+                case BLEND_MASKED:
+                    value = (value & ~l.mask[index]) | (l.pixels[index] & l.mask[index]);
+                    break;
+                }
+            }
+
+            uint8_t& byte = framebuffer[page * DISPLAY::SCREEN_WIDTH + column];
+
+            if (byte != value)
+            {
+                byte = value;
+                changed_start = std::min<uint8_t>(changed_start, column);
+                changed_end = column;
+                this->statistics.columns_changed++;
+            }
+        }
+
+        this->statistics.columns_composed += column_end - column_start + 1u;
+
+        if (changed_start <= changed_end)
+        {
+            this->display.mark_dirty(changed_start, page, changed_end, page);
+        }
+
+        this->damage_start[page] = DISPLAY::SCREEN_WIDTH;
+        this->damage_end[page] = 0u;
+        damaged = true;
+    }
+
+    if (damaged)
+    {
+        this->statistics.compositions++;
+    }
+
+    this->display.flush();
+}
+
+/**
+ * @brief Get the work done by the compositor so far.
+ *
+ * @return ssd1306_compositor_statistics_t Statistics.
+ */
+template <typename DISPLAY>
+ssd1306_compositor_statistics_t ssd1306_compositor_t<DISPLAY>::get_statistics()
+{
+    return this->statistics;
+}
+
+/**
+ * @brief Merge a rectangle in screen coordinates into the damage.
+ *
+ * @param column_start First damaged column.
+ * @param page_start First damaged page.
+ * @param column_end Last damaged column.
+ * @param page_end Last damaged page.
+ */
+template <typename DISPLAY>
+void ssd1306_compositor_t<DISPLAY>::damage_screen(uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end)
+{
+    for (size_t page = page_start; page <= page_end; page++)
+    {
+        this->damage_start[page] = std::min(this->damage_start[page], column_start);
+        this->damage_end[page] = std::max(this->damage_end[page], column_end);
+    }
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_compositor_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_compositor_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_compositor_t<ssd1306_96x16_t>;
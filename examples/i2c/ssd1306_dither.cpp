@@ -0,0 +1,249 @@
+/**
+ * @file ssd1306_dither.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Dithering of 8-bit grayscale images into the page-major framebuffer format of the SSD1306.
+ * @date 18-10-2026
+ *
+ * The result is written directly into a framebuffer: byte (page * width + column) holds 8 rows, LSB on top.
+ * Images are placed at a column and page of the framebuffer and clipped to the framebuffer.
+ * Rows of the last page that are below the image keep their contents.
+ *
+ * Modes:
+ * - Threshold: a pixel is on if its value is at least 128.
+ * - Ordered: a pixel is on if its value is above the value of an 8x8 Bayer matrix.
+ *   One page is built at a time, 16 columns at once, using GCC vector extensions.
+ *   These map to NEON or SSE where available, and to word-sized operations on the ARMv6 of the Pi Zero.
+ * - Floyd-Steinberg: the quantisation error is spread over 4 neighbours (7/16, 3/16, 5/16, 1/16).
+ * - Atkinson: 6/8 of the quantisation error is spread over 6 neighbours, which gives more contrast.
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+#include "include/ssd1306_dither.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* 16 bytes, processed as one vector. */
+typedef uint8_t vector_u8 __attribute__((vector_size(16)));
+static constexpr uint8_t VECTOR_SIZE = sizeof(vector_u8);
+
+/* Bayer matrix scaled to thresholds: 4 * index + 2. */
+static constexpr uint8_t BAYER_THRESHOLDS[8][8] = {
+    {   2, 130,  34, 162,  10, 138,  42, 170 },
+    { 194,  66, 226,  98, 202,  74, 234, 106 },
+    {  50, 178,  18, 146,  58, 186,  26, 154 },
+    { 242, 114, 210,  82, 250, 122, 218,  90 },
+    {  14, 142,  46, 174,   6, 134,  38, 166 },
+    { 206,  78, 238, 110, 198,  70, 230, 102 },
+    {  62, 190,  30, 158,  54, 182,  22, 150 },
+    { 254, 126, 222,  94, 246, 118, 214,  86 }
+};
+
+/* Margin of the error rows on each side. */
+static constexpr uint8_t ERROR_MARGIN = 2u;
+
+/**
+ * @brief Construct a new ssd1306_dither_t object.
+ *
+ * @param framebuffer_width Width of the framebuffer to write to.
+ * @param framebuffer_height Height of the framebuffer to write to.
+ */
+ssd1306_dither_t::ssd1306_dither_t(uint8_t framebuffer_width, uint8_t framebuffer_height) :
+    framebuffer_width(framebuffer_width),
+    framebuffer_height(framebuffer_height),
+    errors(3u * (framebuffer_width + 2u * ERROR_MARGIN))
+{
+    assert(framebuffer_height % 8u == 0u);
+}
+
+/**
+ * @brief Convert a grayscale image and write it into a framebuffer.
+ *
+ * @param mode Dithering mode.
+ * @param image Grayscale image, one byte per pixel (0 = off, 255 = on).
+ * @param width Width of the image.
+ * @param height Height of the image.
+ * @param stride Number of bytes between the start of two rows of the image.
+ * @param framebuffer Page-major framebuffer to write to.
+ * @param x Column of the framebuffer to place the left side of the image at.
+ * @param page Page of the framebuffer to place the top of the image at.
+ */
+void ssd1306_dither_t::convert(dither_mode mode, const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer, uint8_t x, uint8_t page)
+{
+    assert(stride >= width);
+    assert(x < this->framebuffer_width);
+    assert(page < this->framebuffer_height / 8u);
+
+    /* Clip the image to the framebuffer. */
+    width = std::min<uint16_t>(width, this->framebuffer_width - x);
+    height = std::min<uint16_t>(height, this->framebuffer_height - page * 8u);
+    framebuffer += page * this->framebuffer_width + x;
+
+    switch (mode)
+    {
+    case DITHER_THRESHOLD:
+        this->convert_threshold(image, width, height, stride, framebuffer);
+        break;
+    case DITHER_ORDERED:
+        this->convert_ordered(image, width, height, stride, framebuffer);
+        break;
+    case DITHER_FLOYD_STEINBERG:
+    case DITHER_ATKINSON:
+        this->convert_error_diffusion(mode, image, width, height, stride, framebuffer);
+        break;
+    }
+}
+
+/**
+ * @brief Convert an image using a fixed threshold.
+ */
+void ssd1306_dither_t::convert_threshold(const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer)
+{
+    for (size_t y = 0; y < height; y += 8u)
+    {
+        const uint8_t rows = std::min<size_t>(8u, height - y);
+        /* Bits of rows below the image are kept. */
+        const uint8_t keep = 0xFFu << rows;
+        uint8_t* destination = framebuffer + (y / 8u) * this->framebuffer_width;
+
+        for (size_t column = 0; column < width; column++)
+        {
+            uint8_t data = destination[column] & keep;
+
+            for (size_t row = 0; row < rows; row++)
+            {
+                data |= (image[(y + row) * stride + column] >> 7u) << row;
+            }
+
+            destination[column] = data;
+        }
+    }
+}
+
+/**
+ * @brief Convert an image using ordered dithering with an 8x8 Bayer matrix.
+ * Each page is built 16 columns at a time: every row of the page adds its bit to all 16 columns at once.
+ */
+void ssd1306_dither_t::convert_ordered(const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer)
+{
+    /* Thresholds of each matrix row, repeated to fill a vector, and the bit of each row in every lane. */
+    vector_u8 thresholds[8];
+    vector_u8 row_bits[8];
+
+    for (size_t row = 0; row < 8u; row++)
+    {
+        uint8_t repeated[VECTOR_SIZE];
+
+        for (size_t column = 0; column < VECTOR_SIZE; column++)
+        {
+            repeated[column] = BAYER_THRESHOLDS[row][column % 8u];
+        }
+
+        memcpy(&thresholds[row], repeated, VECTOR_SIZE);
+
+        memset(repeated, 1u << row, VECTOR_SIZE);
+        memcpy(&row_bits[row], repeated, VECTOR_SIZE);
+    }
+
+    for (size_t y = 0; y < height; y += 8u)
+    {
+        const uint8_t rows = std::min<size_t>(8u, height - y);
+        const uint8_t keep = 0xFFu << rows;
+        uint8_t* destination = framebuffer + (y / 8u) * this->framebuffer_width;
+        size_t column = 0;
+
+        for (; column + VECTOR_SIZE <= width; column += VECTOR_SIZE)
+        {
+            vector_u8 data;
+
+            memcpy(&data, destination + column, VECTOR_SIZE);
+            data &= keep;
+
+            for (size_t row = 0; row < rows; row++)
+            {
+                vector_u8 pixels;
+
+                memcpy(&pixels, image + (y + row) * stride + column, VECTOR_SIZE);
+                /* Comparison results are all ones for pixels above the threshold. */
+                data |= (vector_u8)(pixels > thresholds[row]) & row_bits[row];
+            }
+
+            memcpy(destination + column, &data, VECTOR_SIZE);
+        }
+
+        /* Remaining columns. */
+        for (; column < width; column++)
+        {
+            uint8_t data = destination[column] & keep;
+
+            for (size_t row = 0; row < rows; row++)
+            {
+                data |= (image[(y + row) * stride + column] > BAYER_THRESHOLDS[row][column % 8u]) << row;
+            }
+
+            destination[column] = data;
+        }
+    }
+}
+
+/**
+ * @brief Convert an image using Floyd-Steinberg or Atkinson error diffusion.
+ * The image is processed row by row; three error rows are kept (the current row and the next two).
+ */
+void ssd1306_dither_t::convert_error_diffusion(dither_mode mode, const uint8_t* image, uint16_t width, uint16_t height, uint16_t stride, uint8_t* framebuffer)
+{
+    const size_t row_size = this->framebuffer_width + 2u * ERROR_MARGIN;
+    int16_t* rows[3] = {
+        &this->errors[0],
+        &this->errors[row_size],
+        &this->errors[2u * row_size]
+    };
+
+    std::fill(this->errors.begin(), this->errors.end(), 0);
+
+    for (size_t y = 0; y < height; y++)
+    {
+        int16_t* current = rows[0] + ERROR_MARGIN;
+        int16_t* next = rows[1] + ERROR_MARGIN;
+        int16_t* after_next = rows[2] + ERROR_MARGIN;
+        uint8_t* destination = framebuffer + (y / 8u) * this->framebuffer_width;
+        const uint8_t bit = 1u << (y % 8u);
+
+        for (size_t column = 0; column < width; column++)
+        {
+            const int16_t value = image[y * stride + column] + current[column];
+            const bool on = value >= 128;
+            const int16_t error = value - (on ? 255 : 0);
+
+            destination[column] = on ? (destination[column] | bit) : (destination[column] & ~bit);
+
+            if (mode == DITHER_FLOYD_STEINBERG)
+            {
+                current[column + 1]  += error * 7 / 16;
+                next[column - 1]     += error * 3 / 16;
+                next[column]         += error * 5 / 16;
+                next[column + 1]     += error * 1 / 16;
+            }
+            else
+            {
+                const int16_t part = error / 8;
+
+                current[column + 1]  += part;
+                current[column + 2]  += part;
+                next[column - 1]     += part;
+                next[column]         += part;
+                next[column + 1]     += part;
+                after_next[column]   += part;
+            }
+        }
+
+        /* Rotate the error rows and clear the new last row. */
+        int16_t* done = rows[0];
+        rows[0] = rows[1];
+        rows[1] = rows[2];
+        rows[2] = done;
+        std::fill(done, done + row_size, 0);
+    }
+}
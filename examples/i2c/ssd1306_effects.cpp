@@ -0,0 +1,207 @@
+/**
+ * @file ssd1306_effects.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Effects that the SSD1306 performs on its own, driven by a handful of commands.
+ * @date 18-10-2026
+ *
+ * A ticker is the continuous horizontal scroll over a range of pages: after the setup, the controller moves the
+ * pages every few frames without any bus traffic. When the scroll is stopped, the GDDRAM contents have moved,
+ * so the framebuffer is written again (page 46 of the data sheet).
+ *
+ * Fades and blinks change a single register over time. update() sends the commands that are due and returns the
+ * time of the next one, so it fits in an existing event loop; run() just sleeps in between.
+ * A fade sends at most one 2-byte contrast command per FADE_STEP_INTERVAL, a blink one byte per inversion.
+ * Note that contrast only changes the brightness a little on most panels, it can not fade to black.
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <thread>
+
+#include "include/ssd1306_effects.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new ssd1306_effects_t object.
+ *
+ * @param display Display to run the effects on. Must be initialised before an effect is started.
+ * @param contrast Current contrast of the display (default: 0x7F, the value after initialisation).
+ */
+template <typename DISPLAY>
+ssd1306_effects_t<DISPLAY>::ssd1306_effects_t(DISPLAY& display, uint8_t contrast) :
+    display(display),
+    steps(0u),
+    fading(false),
+    contrast(contrast),
+    fade_from(contrast),
+    fade_to(contrast),
+    fade_duration(0),
+    blink_toggles(0u),
+    inverted(false),
+    blink_interval(0)
+{}
+
+/**
+ * @brief Scroll a range of pages continuously, like a news ticker. The rest of the screen stays in place.
+ *
+ * @param page_start First page of the ticker.
+ * @param page_end Last page of the ticker.
+ * @param direction Direction of the scroll.
+ * @param interval Number of frames between two steps of one column.
+ */
+template <typename DISPLAY>
+void ssd1306_effects_t<DISPLAY>::start_ticker(uint8_t page_start, uint8_t page_end, typename DISPLAY::continuous_horizontal_scroll_mode direction,
+                                              typename DISPLAY::continuous_horizontal_scroll_interval interval)
+{
+    /* The scroll must be deactivated before it is set up. */
+    this->display.activate_scroll(false);
+    this->display.set_continuous_horizontal_scroll(direction, page_start, interval, page_end);
+    this->display.activate_scroll(true);
+}
+
+/**
+ * @brief Stop the ticker and restore the screen to the framebuffer.
+ */
+template <typename DISPLAY>
+void ssd1306_effects_t<DISPLAY>::stop_ticker()
+{
+    this->display.activate_scroll(false);
+    this->display.display_framebuffer();
+}
+
+/**
+ * @brief Fade the contrast to a new value. A fade that is still running continues from its current contrast.
+ *
+ * @param contrast Contrast at the end of the fade.
+ * @param duration Duration of the fade.
+ * @param now Start time of the fade.
+ */
+template <typename DISPLAY>
+void ssd1306_effects_t<DISPLAY>::fade(uint8_t contrast, std::chrono::milliseconds duration, clock::time_point now)
+{
+    this->fading = true;
+    this->fade_from = this->contrast;
+    this->fade_to = contrast;
+    this->fade_start = now;
+    this->fade_duration = duration;
+    this->fade_next = now;
+
+    this->update(now);
+}
+
+/**
+ * @brief Blink the display by inverting it a number of times. The display ends up not inverted.
+ *
+ * @param count Number of blinks.
+ * @param period Duration of one blink (inverted and back).
+ * @param now Start time of the blink.
+ */
+template <typename DISPLAY>
+void ssd1306_effects_t<DISPLAY>::blink(uint8_t count, std::chrono::milliseconds period, clock::time_point now)
+{
+    assert(count > 0u);
+
+    /* Every blink is two inversions. If the display is inverted by an earlier blink, it is restored first. */
+    this->blink_toggles = 2u * count + (this->inverted ? 1u : 0u);
+    this->blink_interval = period / 2;
+    this->blink_next = now;
+
+    this->update(now);
+}
+
+/**
+ * @brief Check whether a fade or blink is still running. Tickers run until they are stopped.
+ *
+ * @return true if update() still has commands to send.
+ */
+template <typename DISPLAY>
+bool ssd1306_effects_t<DISPLAY>::is_active()
+{
+    return this->fading || this->blink_toggles > 0u;
+}
+
+/**
+ * @brief Send the commands of the fades and blinks that are due.
+ *
+ * @param now Current time.
+ * @return clock::time_point Time at which update() should be called again, or clock::time_point::max() if idle.
+ */
+template <typename DISPLAY>
+typename ssd1306_effects_t<DISPLAY>::clock::time_point ssd1306_effects_t<DISPLAY>::update(clock::time_point now)
+{
+    clock::time_point next = clock::time_point::max();
+
+    if (this->fading && now >= this->fade_next)
+    {
+        const clock::duration elapsed = now - this->fade_start;
+        uint8_t level = this->fade_to;
+
+        if (elapsed < this->fade_duration)
+        {
+            level = this->fade_from + ((int)this->fade_to - (int)this->fade_from) * elapsed.count() / this->fade_duration.count();
+        }
+        else
+        {
+            this->fading = false;
+        }
+
+        if (level != this->contrast)
+        {
+            this->display.set_contrast(level);
+            this->contrast = level;
+            this->steps++;
+        }
+
+        this->fade_next = now + FADE_STEP_INTERVAL;
+    }
+
+    if (this->fading)
+    {
+        next = std::min(next, std::min(this->fade_next, this->fade_start + this->fade_duration));
+    }
+
+    if (this->blink_toggles > 0u && now >= this->blink_next)
+    {
+        this->inverted = !this->inverted;
+        this->display.set_inverse_display(this->inverted);
+        this->steps++;
+        this->blink_toggles--;
+        this->blink_next += this->blink_interval;
+    }
+
+    if (this->blink_toggles > 0u)
+    {
+        next = std::min(next, this->blink_next);
+    }
+
+    return next;
+}
+
+/**
+ * @brief Run the fades and blinks until they are finished, sleeping between the commands.
+ */
+template <typename DISPLAY>
+void ssd1306_effects_t<DISPLAY>::run()
+{
+    while (this->is_active())
+    {
+        std::this_thread::sleep_until(this->update());
+    }
+}
+
+/**
+ * @brief Get the number of effect steps (commands) that were sent.
+ *
+ * @return uint32_t Number of steps.
+ */
+template <typename DISPLAY>
+uint32_t ssd1306_effects_t<DISPLAY>::get_steps()
+{
+    return this->steps;
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_effects_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_effects_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_effects_t<ssd1306_96x16_t>;
@@ -0,0 +1,598 @@
+/**
+ * @file ssd1306_emulator.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Model of an SSD1306 panel for the simulated I2C bus, to test and benchmark display code without hardware.
+ * @date 18-10-2026
+ *
+ * Every I2C message starts with a control byte <Co, D/C, 0, 0, 0, 0, 0, 0>. With Co = 1, a single command
+ * or data byte follows, after which another control byte is expected. With Co = 0, all remaining bytes of
+ * the message are commands (D/C = 0) or GDDRAM data (D/C = 1). Command arguments may arrive in later messages.
+ *
+ * GDDRAM writes follow the addressing mode (pages 34-35 of the data sheet):
+ * - page: the column pointer wraps from 127 to the column start address, the page is not changed,
+ * - horizontal: the column pointer wraps within the column window and then moves to the next page of the page window,
+ * - vertical: the page pointer wraps within the page window and then moves to the next column of the column window.
+ *
+ * The panel is wired to the COM pins in the way that matches its intended COM pins configuration, and to SEG0
+ * onwards. The GDDRAM is stored by segment: the segment remap maps column addresses to segments when data is
+ * written or read, so like on the chip it only affects data written after it.
+ * The rendered image applies the MUX ratio, display offset, start line, COM pin configuration and
+ * left/right remap, COM scan direction, inversion, entire display on and display on/off.
+ * Scrolling is not timed: step_scroll() performs one scroll step on request.
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "include/ssd1306_emulator.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Number of COM pins of the controller. */
+static constexpr uint8_t NUMBER_OF_COMS = 64u;
+
+/**
+ * @brief Get the COM pin that a row of the controller is output on.
+ *
+ * @param row Row index (ROW0-ROW63 in table 10-3 of the data sheet).
+ * @param alternative True for the alternative COM pin configuration.
+ * @param left_right_remap True if the left and right COM pins are swapped.
+ * @return uint8_t COM pin.
+ */
+static uint8_t com_pin(uint8_t row, bool alternative, bool left_right_remap)
+{
+    if (!alternative)
+    {
+        return (row + (left_right_remap ? 32u : 0u)) % NUMBER_OF_COMS;
+    }
+
+    const bool right = (row % 2u) != left_right_remap;
+
+    return (right ? 32u : 0u) + row / 2u;
+}
+
+/**
+ * @brief Construct a new ssd1306_emulator_exception object. Used when an image cannot be saved.
+ *
+ * @param message Error message.
+ */
+ssd1306_emulator_exception::ssd1306_emulator_exception(const std::string& message) :
+    runtime_error(message)
+{}
+
+/**
+ * @brief Construct a new ssd1306_emulator_t object. The controller is in its reset state.
+ *
+ * @param width Number of columns of the panel.
+ * @param height Number of rows of the panel.
+ * @param wiring COM pins configuration the panel is wired for.
+ */
+ssd1306_emulator_t::ssd1306_emulator_t(uint8_t width, uint8_t height, ssd1306_com_pins_configuration wiring) :
+    width(width),
+    height(height),
+    wiring(wiring),
+    gddram{},
+    data_mode(false),
+    scroll_line(0u)
+{
+    assert(width <= GDDRAM_WIDTH && height <= NUMBER_OF_COMS);
+}
+
+/**
+ * @brief Receive an I2C write message.
+ *
+ * @param data Bytes of the message.
+ * @param size Number of bytes.
+ * @return true, the device always acknowledges.
+ */
+bool ssd1306_emulator_t::i2c_sim_write(const uint8_t* data, uint16_t size)
+{
+    size_t i = 0;
+
+    this->counters.transactions++;
+    this->counters.bytes += size;
+
+    while (i < size)
+    {
+        const uint8_t control = data[i++];
+        const bool continuation = control & 0x80u;
+
+        this->data_mode = control & 0x40u;
+
+        /* With Co = 1, only the next byte uses this control byte. */
+        const size_t end = continuation ? std::min<size_t>(i + 1u, size) : size;
+
+        for (; i < end; i++)
+        {
+            if (this->data_mode)
+            {
+                this->write_data_byte(data[i]);
+            }
+            else
+            {
+                this->write_command_byte(data[i]);
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Receive an I2C read message. Returns the status byte after a command control byte,
+ * and GDDRAM contents after a data control byte.
+ *
+ * @param buffer Buffer to store the read bytes into.
+ * @param size Number of bytes to read.
+ * @return true, the device always acknowledges.
+ */
+bool ssd1306_emulator_t::i2c_sim_read(uint8_t* buffer, uint16_t size)
+{
+    this->counters.transactions++;
+    this->counters.bytes += size;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        /* Status register: D6 is set when the display is off. */
+        buffer[i] = this->data_mode ? this->read_data_byte() : (this->state.display_on ? 0x00u : 0x40u);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Receive bytes in 4-wire SPI mode. There are no control bytes, the D/C pin selects command or data.
+ *
+ * @param data Bytes of the transfer.
+ * @param size Number of bytes.
+ * @param dc State of the D/C pin: false for commands, true for data.
+ */
+void ssd1306_emulator_t::spi_sim_write(const uint8_t* data, uint32_t size, bool dc)
+{
+    this->counters.transactions++;
+    this->counters.bytes += size;
+    this->data_mode = dc;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        if (dc)
+        {
+            this->write_data_byte(data[i]);
+        }
+        else
+        {
+            this->write_command_byte(data[i]);
+        }
+    }
+}
+
+/**
+ * @brief Render the image that the panel shows.
+ *
+ * @return std::vector<uint8_t> One byte per pixel, row by row; 1 if the pixel is lit.
+ */
+std::vector<uint8_t> ssd1306_emulator_t::render()
+{
+    std::vector<uint8_t> image(this->width * this->height, 0u);
+    const ssd1306_emulator_state_t& s = this->state;
+
+    if (!s.display_on)
+    {
+        return image;
+    }
+
+    for (size_t y = 0; y < this->height; y++)
+    {
+        const uint8_t pin = com_pin(y, this->wiring == COM_PINS_HARDWARE_ALTERNATIVE, false);
+        uint8_t row = 0u;
+
+        /* Find the row of the controller that drives the COM pin of this panel row. */
+        while (com_pin(row, s.com_pins_alternative, s.com_left_right_remap) != pin)
+        {
+            row++;
+        }
+
+        /* Rows beyond the MUX ratio are not driven. */
+        if (row >= s.multiplex_ratio)
+        {
+            continue;
+        }
+
+        const uint8_t counter = s.com_scan_remapped ? s.multiplex_ratio - 1u - row : row;
+        const uint8_t ram_row = (s.start_line + s.display_offset + this->scroll_line + counter) % NUMBER_OF_COMS;
+
+        for (size_t x = 0; x < this->width; x++)
+        {
+            const bool bit = (this->gddram[(ram_row / 8u) * GDDRAM_WIDTH + x] >> (ram_row % 8u)) & 1u;
+
+            image[y * this->width + x] = s.entire_display_on ? 1u : (bit != s.inverse);
+        }
+    }
+
+    return image;
+}
+
+/**
+ * @brief Save the rendered image as a binary PBM file. Lit pixels are stored as 1 (black).
+ *
+ * @param file_name Name of the file.
+ */
+void ssd1306_emulator_t::save_pbm(const std::string& file_name)
+{
+    const std::vector<uint8_t> image = this->render();
+    const size_t row_size = (this->width + 7u) / 8u;
+    std::vector<uint8_t> rows(row_size * this->height, 0u);
+    FILE* file = fopen(file_name.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        throw ssd1306_emulator_exception("could not create image file " + file_name);
+    }
+
+    for (size_t y = 0; y < this->height; y++)
+    {
+        for (size_t x = 0; x < this->width; x++)
+        {
+            rows[y * row_size + x / 8u] |= image[y * this->width + x] << (7u - x % 8u);
+        }
+    }
+
+    const bool written = fprintf(file, "P4\n%u %u\n", this->width, this->height) > 0 &&
+                         fwrite(rows.data(), 1u, rows.size(), file) == rows.size();
+
+    if (fclose(file) != 0 || !written)
+    {
+        throw ssd1306_emulator_exception("could not write image file " + file_name);
+    }
+}
+
+/**
+ * @brief Append a 32-bit big-endian value.
+ */
+static void append_u32(std::vector<uint8_t>& output, uint32_t value)
+{
+    output.push_back(value >> 24u);
+    output.push_back(value >> 16u);
+    output.push_back(value >> 8u);
+    output.push_back(value);
+}
+
+/**
+ * @brief Append a PNG chunk with its length and CRC.
+ */
+static void append_png_chunk(std::vector<uint8_t>& output, const char type[4], const std::vector<uint8_t>& data)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+
+    append_u32(output, data.size());
+
+    const size_t start = output.size();
+
+    output.insert(output.end(), type, type + 4);
+    output.insert(output.end(), data.begin(), data.end());
+
+    for (size_t i = start; i < output.size(); i++)
+    {
+        crc ^= output[i];
+
+        for (size_t bit = 0; bit < 8u; bit++)
+        {
+            crc = (crc >> 1u) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+
+    append_u32(output, crc ^ 0xFFFFFFFFu);
+}
+
+/**
+ * @brief Save the rendered image as an 8-bit grayscale PNG file. Lit pixels are white.
+ * The image data is stored without compression.
+ *
+ * @param file_name Name of the file.
+ */
+void ssd1306_emulator_t::save_png(const std::string& file_name)
+{
+    static constexpr uint8_t SIGNATURE[8] = { 0x89u, 'P', 'N', 'G', '\r', '\n', 0x1Au, '\n' };
+    const std::vector<uint8_t> image = this->render();
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> header;
+    std::vector<uint8_t> zlib = { 0x78u, 0x01u };
+    std::vector<uint8_t> output(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    uint32_t adler_a = 1u;
+    uint32_t adler_b = 0u;
+
+    /* Every row starts with filter type 0 (none). */
+    for (size_t y = 0; y < this->height; y++)
+    {
+        raw.push_back(0u);
+
+        for (size_t x = 0; x < this->width; x++)
+        {
+            raw.push_back(image[y * this->width + x] ? 0xFFu : 0x00u);
+        }
+    }
+
+    /* Stored deflate blocks of at most 65535 bytes. */
+    for (size_t offset = 0; offset < raw.size(); offset += 0xFFFFu)
+    {
+        const uint16_t size = std::min<size_t>(0xFFFFu, raw.size() - offset);
+
+        zlib.push_back(offset + size == raw.size() ? 1u : 0u);
+        zlib.push_back(size);
+        zlib.push_back(size >> 8u);
+        zlib.push_back(~size);
+        zlib.push_back(~size >> 8u);
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+    }
+
+    for (uint8_t byte : raw)
+    {
+        adler_a = (adler_a + byte) % 65521u;
+        adler_b = (adler_b + adler_a) % 65521u;
+    }
+
+    append_u32(zlib, (adler_b << 16u) | adler_a);
+
+    append_u32(header, this->width);
+    append_u32(header, this->height);
+    /* 8 bits per sample, grayscale, deflate, adaptive filtering, no interlace. */
+    header.insert(header.end(), { 8u, 0u, 0u, 0u, 0u });
+
+    append_png_chunk(output, "IHDR", header);
+    append_png_chunk(output, "IDAT", zlib);
+    append_png_chunk(output, "IEND", {});
+
+    FILE* file = fopen(file_name.c_str(), "wb");
+
+    if (file == nullptr)
+    {
+        throw ssd1306_emulator_exception("could not create image file " + file_name);
+    }
+
+    const bool written = fwrite(output.data(), 1u, output.size(), file) == output.size();
+
+    if (fclose(file) != 0 || !written)
+    {
+        throw ssd1306_emulator_exception("could not write image file " + file_name);
+    }
+}
+
+/**
+ * @brief Perform one step of the active scroll. Horizontal scrolling moves the GDDRAM contents of the scrolled
+ * pages by one column, vertical scrolling moves the displayed rows by the vertical offset.
+ */
+void ssd1306_emulator_t::step_scroll()
+{
+    const ssd1306_emulator_state_t& s = this->state;
+
+    if (!s.scroll_active || s.scroll_command == 0u)
+    {
+        return;
+    }
+
+    /* 0x26 and 0x29 scroll right, 0x27 and 0x2A scroll left. */
+    const bool right = s.scroll_command == 0x26u || s.scroll_command == 0x29u;
+
+    for (size_t page = s.scroll_start_page; page <= s.scroll_end_page && page < GDDRAM_PAGES; page++)
+    {
+        uint8_t* row = &this->gddram[page * GDDRAM_WIDTH];
+
+        if (right)
+        {
+            const uint8_t last = row[GDDRAM_WIDTH - 1u];
+            memmove(row + 1, row, GDDRAM_WIDTH - 1u);
+            row[0] = last;
+        }
+        else
+        {
+            const uint8_t first = row[0];
+            memmove(row, row + 1, GDDRAM_WIDTH - 1u);
+            row[GDDRAM_WIDTH - 1u] = first;
+        }
+    }
+
+    if (s.scroll_command == 0x29u || s.scroll_command == 0x2Au)
+    {
+        this->scroll_line = (this->scroll_line + s.scroll_offset) % NUMBER_OF_COMS;
+    }
+}
+
+/**
+ * @brief Reset the traffic counters, e.g. at the start of a frame.
+ */
+void ssd1306_emulator_t::reset_counters()
+{
+    this->counters = {};
+}
+
+/**
+ * @brief Get the contents of the GDDRAM.
+ *
+ * @return const uint8_t* 8 pages of 128 bytes, indexed by segment.
+ */
+const uint8_t* ssd1306_emulator_t::get_gddram()
+{
+    return this->gddram;
+}
+
+/**
+ * @brief Handle a command byte. Multi-byte commands are executed when all arguments have arrived.
+ *
+ * @param byte Command byte.
+ */
+void ssd1306_emulator_t::write_command_byte(uint8_t byte)
+{
+    this->counters.command_bytes++;
+    this->command.push_back(byte);
+
+    size_t length;
+
+    switch (this->command[0])
+    {
+    case 0x81u: case 0x8Du: case 0x20u: case 0xA8u: case 0xD3u:
+    case 0xDAu: case 0xD5u: case 0xD9u: case 0xDBu:
+        length = 2u;
+        break;
+    case 0x21u: case 0x22u: case 0xA3u:
+        length = 3u;
+        break;
+    case 0x29u: case 0x2Au:
+        length = 6u;
+        break;
+    case 0x26u: case 0x27u:
+        length = 7u;
+        break;
+    default:
+        length = 1u;
+        break;
+    }
+
+    if (this->command.size() == length)
+    {
+        this->execute_command();
+        this->command.clear();
+    }
+}
+
+/**
+ * @brief Execute a complete command.
+ */
+void ssd1306_emulator_t::execute_command()
+{
+    ssd1306_emulator_state_t& s = this->state;
+    const uint8_t* c = this->command.data();
+
+    if (c[0] <= 0x0Fu)
+    {
+        /* Lower nibble of the column start address in page addressing mode. */
+        s.page_column_start = (s.page_column_start & 0xF0u) | c[0];
+        s.column = s.page_column_start;
+    }
+    else if (c[0] <= 0x1Fu)
+    {
+        s.page_column_start = (s.page_column_start & 0x0Fu) | ((c[0] & 0x07u) << 4u);
+        s.column = s.page_column_start;
+    }
+    else if (c[0] >= 0x40u && c[0] <= 0x7Fu)
+    {
+        s.start_line = c[0] & 0x3Fu;
+    }
+    else if (c[0] >= 0xB0u && c[0] <= 0xB7u)
+    {
+        s.page = c[0] & 0x07u;
+    }
+    else switch (c[0])
+    {
+    case 0x81u: s.contrast = c[1]; break;
+    case 0x8Du: s.charge_pump = c[1] & 0x04u; break;
+    case 0x20u: s.addressing_mode = c[1] & 0x03u; break;
+    case 0x21u:
+        s.column_start = s.column = c[1] & 0x7Fu;
+        s.column_end = c[2] & 0x7Fu;
+        break;
+    case 0x22u:
+        s.page_start = s.page = c[1] & 0x07u;
+        s.page_end = c[2] & 0x07u;
+        break;
+    case 0xA8u: s.multiplex_ratio = (c[1] & 0x3Fu) + 1u; break;
+    case 0xD3u: s.display_offset = c[1] & 0x3Fu; break;
+    case 0xDAu:
+        s.com_pins_alternative = c[1] & 0x10u;
+        s.com_left_right_remap = c[1] & 0x20u;
+        break;
+    case 0xD5u: s.clock = c[1]; break;
+    case 0xD9u: s.pre_charge_period = c[1]; break;
+    case 0xDBu: s.v_comh_level = c[1]; break;
+    case 0xA3u:
+        s.scroll_fixed_rows = c[1] & 0x3Fu;
+        s.scroll_rows = c[2] & 0x7Fu;
+        break;
+    case 0x26u: case 0x27u: case 0x29u: case 0x2Au:
+        s.scroll_command = c[0];
+        s.scroll_start_page = c[2] & 0x07u;
+        s.scroll_interval = c[3] & 0x07u;
+        s.scroll_end_page = c[4] & 0x07u;
+        s.scroll_offset = (c[0] >= 0x29u) ? (c[5] & 0x3Fu) : 0u;
+        break;
+    case 0x2Eu: s.scroll_active = false; break;
+    case 0x2Fu: s.scroll_active = true; break;
+    case 0xA0u: case 0xA1u: s.segment_remap = c[0] & 1u; break;
+    case 0xA4u: case 0xA5u: s.entire_display_on = c[0] & 1u; break;
+    case 0xA6u: case 0xA7u: s.inverse = c[0] & 1u; break;
+    case 0xAEu: case 0xAFu: s.display_on = c[0] & 1u; break;
+    case 0xC0u: case 0xC8u: s.com_scan_remapped = c[0] & 0x08u; break;
+    default:
+        /* NOP and unknown commands. */
+        break;
+    }
+}
+
+/**
+ * @brief Write a byte to the GDDRAM at the pointer and advance the pointer.
+ *
+ * @param byte Data byte.
+ */
+void ssd1306_emulator_t::write_data_byte(uint8_t byte)
+{
+    this->counters.data_bytes++;
+    this->gddram[this->state.page * GDDRAM_WIDTH + this->segment()] = byte;
+    this->advance_pointer();
+}
+
+/**
+ * @brief Read the byte at the pointer from the GDDRAM and advance the pointer.
+ *
+ * @return uint8_t Data byte.
+ */
+uint8_t ssd1306_emulator_t::read_data_byte()
+{
+    const uint8_t byte = this->gddram[this->state.page * GDDRAM_WIDTH + this->segment()];
+
+    this->advance_pointer();
+
+    return byte;
+}
+
+/**
+ * @brief Get the segment of the column at the pointer, which the segment remap at the time of the access decides.
+ *
+ * @return uint8_t Segment, the column in the GDDRAM.
+ */
+uint8_t ssd1306_emulator_t::segment()
+{
+    return this->state.segment_remap ? GDDRAM_WIDTH - 1u - this->state.column : this->state.column;
+}
+
+/**
+ * @brief Advance the GDDRAM pointer according to the addressing mode.
+ */
+void ssd1306_emulator_t::advance_pointer()
+{
+    ssd1306_emulator_state_t& s = this->state;
+
+    switch (s.addressing_mode)
+    {
+    case 0b00u:
+        if (s.column++ >= s.column_end)
+        {
+            s.column = s.column_start;
+            s.page = s.page >= s.page_end ? s.page_start : s.page + 1u;
+        }
+        break;
+    case 0b01u:
+        if (s.page++ >= s.page_end)
+        {
+            s.page = s.page_start;
+            s.column = s.column >= s.column_end ? s.column_start : s.column + 1u;
+        }
+        break;
+    default:
+        if (s.column++ >= GDDRAM_WIDTH - 1u)
+        {
+            s.column = s.page_column_start;
+        }
+        break;
+    }
+}
@@ -0,0 +1,162 @@
+/**
+ * @file ssd1306_grayscale.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Pseudo-grayscale on the SSD1306 using temporal dithering.
+ * @date 18-10-2026
+ *
+ * A frame with 2 or 3 bits per pixel (4 or 8 levels) is split into 2^bits - 1 bitplanes.
+ * In bitplane k, a pixel is on if its level is above k, so a pixel with level n is on in n bitplanes.
+ * Showing the bitplanes one after the other makes the pixel appear n / (2^bits - 1) bright.
+ *
+ * With this encoding, two consecutive bitplanes only differ in the pixels of a single level, except when the
+ * sequence wraps from the last bitplane (only the top level on) to the first (every level but 0 on), where the
+ * pixels of all levels between 0 and the top level change. Only the columns that differ from the bitplane on the
+ * screen are written, so the achievable rate depends on the image: a few levels in a small area can be shown much
+ * faster than a full gradient.
+ * Driving the display as fast as possible also makes this a stress test of the I2C path.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "include/ssd1306_grayscale.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new ssd1306_grayscale_t object.
+ *
+ * @param display Display to show the frames on.
+ * @param bits Bits per pixel of the frames, 2 or 3.
+ */
+template <typename DISPLAY>
+ssd1306_grayscale_t<DISPLAY>::ssd1306_grayscale_t(DISPLAY& display, uint8_t bits) :
+    display(display),
+    subframe_count((1u << bits) - 1u),
+    subframe(0u),
+    bytes(0u),
+    bitplanes(((1u << bits) - 1u) * DISPLAY::FRAMEBUFFER_SIZE, 0u)
+{
+    assert(bits == 2u || bits == 3u);
+}
+
+/**
+ * @brief Set the frame to show and generate its bitplanes.
+ *
+ * @param levels Gray level of each pixel, between 0 (off) and 2^bits - 1 (on).
+ */
+template <typename DISPLAY>
+void ssd1306_grayscale_t<DISPLAY>::set_frame(const uint8_t levels[DISPLAY::SCREEN_HEIGHT][DISPLAY::SCREEN_WIDTH])
+{
+    for (size_t k = 0; k < this->subframe_count; k++)
+    {
+        uint8_t* bitplane = &this->bitplanes[k * DISPLAY::FRAMEBUFFER_SIZE];
+
+        for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+        {
+            for (size_t column = 0; column < DISPLAY::SCREEN_WIDTH; column++)
+            {
+                uint8_t data = 0u;
+
+                for (size_t pixel = 0; pixel < 8u; pixel++)
+                {
+                    assert(levels[page * 8u + pixel][column] <= this->subframe_count);
+
+                    data |= (levels[page * 8u + pixel][column] > k) << pixel;
+                }
+
+                bitplane[page * DISPLAY::SCREEN_WIDTH + column] = data;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Show the next bitplane. Only the columns that differ from the framebuffer of the display are written.
+ */
+template <typename DISPLAY>
+void ssd1306_grayscale_t<DISPLAY>::show_subframe()
+{
+    const uint8_t* bitplane = &this->bitplanes[this->subframe * DISPLAY::FRAMEBUFFER_SIZE];
+    uint8_t* framebuffer = this->display.get_framebuffer();
+
+    for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+    {
+        const uint8_t* source = bitplane + page * DISPLAY::SCREEN_WIDTH;
+        uint8_t* destination = framebuffer + page * DISPLAY::SCREEN_WIDTH;
+        int16_t first = -1;
+        int16_t last = -1;
+
+        for (size_t column = 0; column < DISPLAY::SCREEN_WIDTH; column++)
+        {
+            if (source[column] != destination[column])
+            {
+                first = first < 0 ? column : first;
+                last = column;
+            }
+        }
+
+        if (first >= 0)
+        {
+            memcpy(destination + first, source + first, last - first + 1);
+            this->display.mark_dirty(first, page, last, page);
+            this->bytes += last - first + 1;
+        }
+    }
+
+    this->display.flush();
+
+    this->subframe = (this->subframe + 1u) % this->subframe_count;
+}
+
+/**
+ * @brief Show bitplanes as fast as possible for a given time and measure the achieved rate.
+ *
+ * @param duration Time to drive the display.
+ * @return ssd1306_grayscale_statistics_t Achieved rates, and whether they are high enough to avoid flicker.
+ */
+template <typename DISPLAY>
+ssd1306_grayscale_statistics_t ssd1306_grayscale_t<DISPLAY>::run(std::chrono::milliseconds duration)
+{
+    ssd1306_grayscale_statistics_t statistics;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point now = start;
+
+    this->bytes = 0u;
+
+    while (now - start < duration)
+    {
+        this->show_subframe();
+        statistics.subframes++;
+        now = std::chrono::steady_clock::now();
+    }
+
+    const double seconds = std::chrono::duration<double>(now - start).count();
+
+    statistics.bytes = this->bytes;
+
+    if (seconds > 0.0)
+    {
+        statistics.subframes_per_second = statistics.subframes / seconds;
+        statistics.cycles_per_second = statistics.subframes_per_second / this->subframe_count;
+        statistics.flicker_free = statistics.cycles_per_second >= FLICKER_FUSION_HZ;
+    }
+
+    return statistics;
+}
+
+/**
+ * @brief Get the number of bitplanes per grayscale frame.
+ *
+ * @return uint8_t 2^bits - 1.
+ */
+template <typename DISPLAY>
+uint8_t ssd1306_grayscale_t<DISPLAY>::get_subframe_count()
+{
+    return this->subframe_count;
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_grayscale_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_grayscale_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_grayscale_t<ssd1306_96x16_t>;
@@ -0,0 +1,297 @@
+/**
+ * @file ssd1306_group.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Flush scheduling for several SSD1306 panels on the same I2C bus.
+ * @date 18-10-2026
+ *
+ * Two panels can share a bus by using a different SA0 pin (address_lsb). Flushing them one after the other
+ * makes the second panel wait for a complete frame of the first. The group instead writes one dirty span
+ * (the changed columns of one page, at most one I2C burst) per step and moves on to the next panel,
+ * so every panel gets a fair share of the bus.
+ *
+ * A panel that mirrors another panel has no content of its own: every span written to the source is
+ * written to the mirror as well, from the framebuffer of the source.
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+#include "include/ssd1306_group.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new, empty ssd1306_group_t object.
+ */
+template <typename DISPLAY>
+ssd1306_group_t<DISPLAY>::ssd1306_group_t() :
+    next_panel(0u),
+    statistics_start(clock::now())
+{}
+
+/**
+ * @brief Add a panel to the group. All panels must be on the same I2C bus.
+ *
+ * @param panel Panel to add.
+ * @return uint8_t Index of the panel in the group.
+ */
+template <typename DISPLAY>
+uint8_t ssd1306_group_t<DISPLAY>::add_panel(DISPLAY& panel)
+{
+    assert(this->panels.size() < NO_SOURCE);
+
+    this->panels.push_back({ &panel, NO_SOURCE, false, clock::time_point(), {}, 0.0 });
+
+    return this->panels.size() - 1u;
+}
+
+/**
+ * @brief Make a panel show the framebuffer of another panel.
+ *
+ * @param source Index of the panel whose framebuffer is shown.
+ * @param target Index of the panel that mirrors the source.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::mirror(uint8_t source, uint8_t target)
+{
+    assert(source < this->panels.size() && target < this->panels.size());
+    assert(source != target);
+    /* Mirrors cannot be chained. */
+    assert(this->panels[source].source == NO_SOURCE);
+
+    this->panels[target].source = source;
+
+    /* Bring the mirror up to date with the complete source framebuffer. */
+    memcpy(this->panels[target].display->get_framebuffer(), this->panels[source].display->get_framebuffer(), DISPLAY::FRAMEBUFFER_SIZE);
+    this->panels[source].display->mark_dirty();
+}
+
+/**
+ * @brief Append a panel to the right side of the canvas.
+ *
+ * @param panel Index of the panel.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::add_to_canvas(uint8_t panel)
+{
+    assert(panel < this->panels.size());
+    assert(this->panels[panel].source == NO_SOURCE);
+
+    this->canvas.push_back(panel);
+}
+
+/**
+ * @brief Initialise all panels in the group. The shared I2C bus is initialised by the first panel.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::initialise()
+{
+    for (panel_t& panel : this->panels)
+    {
+        panel.display->initialise();
+    }
+
+    this->reset_statistics();
+}
+
+/**
+ * @brief Write a single dirty span of the next panel that has one.
+ *
+ * @return true if a span was written, false if all panels are clean.
+ */
+template <typename DISPLAY>
+bool ssd1306_group_t<DISPLAY>::flush_step()
+{
+    const size_t count = this->panels.size();
+
+    /* Start the latency measurement of panels that received new content, at the time it was marked dirty. */
+    for (panel_t& panel : this->panels)
+    {
+        if (panel.source == NO_SOURCE && !panel.pending && panel.display->is_dirty())
+        {
+            panel.pending = true;
+            panel.pending_since = panel.display->get_dirty_since();
+        }
+    }
+
+    for (size_t n = 0; n < count; n++)
+    {
+        const uint8_t index = (this->next_panel + n) % count;
+        panel_t& panel = this->panels[index];
+        uint8_t page;
+        uint8_t column_start;
+        uint8_t column_end;
+
+        if (panel.source != NO_SOURCE || !panel.pending)
+        {
+            continue;
+        }
+
+        if (panel.display->take_dirty_span(page, column_start, column_end))
+        {
+            const uint8_t* data = panel.display->get_framebuffer() + page * DISPLAY::SCREEN_WIDTH + column_start;
+            const uint8_t size = column_end - column_start + 1u;
+
+            panel.display->write_span(page, column_start, column_end, data);
+            panel.statistics.bytes += size;
+
+            /* Write the same span to all mirrors of this panel. */
+            for (panel_t& mirror : this->panels)
+            {
+                if (mirror.source == index)
+                {
+                    uint8_t* mirror_data = mirror.display->get_framebuffer() + page * DISPLAY::SCREEN_WIDTH + column_start;
+
+                    /* Sent from the framebuffer of the mirror, so without a copy. */
+                    memcpy(mirror_data, data, size);
+                    mirror.display->write_span(page, column_start, column_end, mirror_data);
+                    mirror.statistics.bytes += size;
+                }
+            }
+        }
+
+        if (!panel.display->is_dirty())
+        {
+            this->complete_frame(index, clock::now());
+        }
+
+        /* Continue with the next panel in the next step. */
+        this->next_panel = (index + 1u) % count;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Write all dirty spans of all panels, interleaved.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::flush()
+{
+    while (this->flush_step());
+}
+
+/**
+ * @brief Get the width of the canvas, which is the total width of the panels in the canvas.
+ *
+ * @return uint16_t Width of the canvas in pixels.
+ */
+template <typename DISPLAY>
+uint16_t ssd1306_group_t<DISPLAY>::get_canvas_width()
+{
+    return this->canvas.size() * DISPLAY::SCREEN_WIDTH;
+}
+
+/**
+ * @brief Set or clear a pixel on the canvas. The change is written by the next flush.
+ *
+ * @param x Column on the canvas.
+ * @param y Row on the canvas.
+ * @param value If true the pixel is turned on, if false it is turned off.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::set_canvas_pixel(uint16_t x, uint8_t y, bool value)
+{
+    assert(x < this->get_canvas_width());
+    assert(y < DISPLAY::SCREEN_HEIGHT);
+
+    DISPLAY* display = this->panels[this->canvas[x / DISPLAY::SCREEN_WIDTH]].display;
+    const uint8_t column = x % DISPLAY::SCREEN_WIDTH;
+    const uint8_t page = y / 8u;
+    uint8_t& data = display->get_framebuffer()[page * DISPLAY::SCREEN_WIDTH + column];
+    const uint8_t bit = 1u << (y % 8u);
+
+    data = value ? (data | bit) : (data & ~bit);
+
+    display->mark_dirty(column, page, column, page);
+}
+
+/**
+ * @brief Clear all panels of the canvas. The change is written by the next flush.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::clear_canvas()
+{
+    for (uint8_t panel : this->canvas)
+    {
+        memset(this->panels[panel].display->get_framebuffer(), 0u, DISPLAY::FRAMEBUFFER_SIZE);
+        this->panels[panel].display->mark_dirty();
+    }
+}
+
+/**
+ * @brief Get the flush statistics since the last reset.
+ *
+ * @return ssd1306_group_statistics_t Aggregate and per-panel statistics.
+ */
+template <typename DISPLAY>
+ssd1306_group_statistics_t ssd1306_group_t<DISPLAY>::get_statistics()
+{
+    ssd1306_group_statistics_t statistics;
+    const double seconds = std::chrono::duration<double>(clock::now() - this->statistics_start).count();
+    uint32_t frames = 0u;
+
+    for (panel_t& panel : this->panels)
+    {
+        statistics.panels.push_back(panel.statistics);
+        statistics.bytes += panel.statistics.bytes;
+        frames += panel.statistics.frames;
+    }
+
+    if (seconds > 0.0)
+    {
+        statistics.frames_per_second = frames / seconds;
+    }
+
+    return statistics;
+}
+
+/**
+ * @brief Reset the flush statistics of all panels.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::reset_statistics()
+{
+    for (panel_t& panel : this->panels)
+    {
+        panel.statistics = {};
+        panel.total_latency_ms = 0.0;
+    }
+
+    this->statistics_start = clock::now();
+}
+
+/**
+ * @brief Record a completely written frame for a panel and its mirrors.
+ *
+ * @param panel Index of the panel.
+ * @param now Time at which the frame was completed.
+ */
+template <typename DISPLAY>
+void ssd1306_group_t<DISPLAY>::complete_frame(uint8_t panel, clock::time_point now)
+{
+    const double latency_ms = std::chrono::duration<double, std::milli>(now - this->panels[panel].pending_since).count();
+
+    for (size_t i = 0; i < this->panels.size(); i++)
+    {
+        panel_t& current = this->panels[i];
+
+        if (i == panel || current.source == panel)
+        {
+            current.statistics.frames++;
+            current.total_latency_ms += latency_ms;
+            current.statistics.average_latency_ms = current.total_latency_ms / current.statistics.frames;
+            current.statistics.max_latency_ms = std::max(current.statistics.max_latency_ms, latency_ms);
+        }
+    }
+
+    this->panels[panel].pending = false;
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_group_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_group_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_group_t<ssd1306_96x16_t>;
@@ -0,0 +1,476 @@
+/**
+ * @file ssd1306_server.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Display server that lets several processes draw on the same SSD1306.
+ * @date 18-10-2026
+ *
+ * The server owns the display and creates a POSIX shared memory object with a fixed number of layers.
+ * A client claims a free layer and draws in its pixels and mask, which are plain shared memory, so drawing
+ * needs no system calls. After drawing, the client posts the damaged columns per page, which are merged
+ * with atomic operations, and increments the damage sequence. Only when the server sleeps on the sequence
+ * (a futex), the client wakes it with a system call.
+ *
+ * The server takes the damage of all layers, composites the damaged columns from the bottom layer to the top
+ * layer (a set mask bit replaces the pixel below it) into the framebuffer and flushes the dirty spans.
+ * Layers of processes that no longer exist are released by the server.
+ *
+ * Publishing damage after the pixels, and the server taking it before reading them, makes the pixels visible to
+ * the server. The server announces that it will sleep before it checks for damage, and a client increments the
+ * sequence before it checks whether the server sleeps, so a notification can not get lost.
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "include/ssd1306_server.hpp"
+
+using namespace pi_zero_peripherals;
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared memory atomics must be lock-free");
+static_assert(std::atomic<uint16_t>::is_always_lock_free, "shared memory atomics must be lock-free");
+
+/**
+ * @brief Construct a new ssd1306_server_exception object. Used when the shared memory of the display server cannot be set up.
+ *
+ * @param message Error message.
+ */
+ssd1306_server_exception::ssd1306_server_exception(const std::string& message) :
+    runtime_error(message)
+{}
+
+/**
+ * @brief Sleep on a futex in shared memory while it has a value.
+ *
+ * @param word Futex word.
+ * @param value Value to sleep on.
+ * @param timeout Maximum time to sleep.
+ */
+static void futex_wait(std::atomic<uint32_t>* word, uint32_t value, std::chrono::milliseconds timeout)
+{
+    const struct timespec time = {
+        .tv_sec  = (time_t)(timeout.count() / 1000),
+        .tv_nsec = (long)(timeout.count() % 1000) * 1000000L
+    };
+
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, value, &time, nullptr, 0);
+}
+
+/**
+ * @brief Wake all processes that sleep on a futex in shared memory.
+ *
+ * @param word Futex word.
+ */
+static void futex_wake(std::atomic<uint32_t>* word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Map the shared memory of a display server.
+ *
+ * @param name Name of the shared memory object.
+ * @param create If true, the object is created and must not exist yet, otherwise an existing object is opened.
+ * @param mode Permissions of a created object.
+ * @return ssd1306_shm_t* Mapped shared memory.
+ */
+static ssd1306_shm_t* map_shm(const std::string& name, bool create, mode_t mode = 0600)
+{
+    const int fd = shm_open(name.c_str(), create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, mode);
+
+    if (fd == -1 && errno == EEXIST)
+    {
+        /* Another server uses the name, or a crashed server left it behind and it must be removed by hand. */
+        throw ssd1306_server_exception("shared memory " + name + " already exists");
+    }
+
+    if (fd == -1)
+    {
+        throw ssd1306_server_exception("could not open shared memory " + name);
+    }
+
+    if (create && ftruncate(fd, sizeof(ssd1306_shm_t)) == -1)
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw ssd1306_server_exception("could not size shared memory " + name);
+    }
+
+    void* memory = mmap(nullptr, sizeof(ssd1306_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    /* The mapping stays valid after closing the file. */
+    close(fd);
+
+    if (memory == MAP_FAILED)
+    {
+        throw ssd1306_server_exception("could not map shared memory " + name);
+    }
+
+    return static_cast<ssd1306_shm_t*>(memory);
+}
+
+/**
+ * @brief Merge a span of columns into the damage of a page.
+ *
+ * @param damage Damage of the page.
+ * @param column_start First damaged column.
+ * @param column_end Last damaged column.
+ */
+static void merge_damage(std::atomic<uint16_t>& damage, uint8_t column_start, uint8_t column_end)
+{
+    uint16_t current = damage.load();
+    uint16_t merged;
+
+    do
+    {
+        merged = std::min<uint8_t>(current & 0xFFu, column_start) | std::max<uint8_t>(current >> 8u, column_end) << 8u;
+    } while (merged != current && !damage.compare_exchange_weak(current, merged));
+}
+
+/**
+ * @brief Construct a new ssd1306_server_t object and create its shared memory.
+ *
+ * @param display Display to composite the layers on. Must be initialised.
+ * @param name Name of the shared memory object (default: "/ssd1306").
+ * @param mode Permissions of the shared memory object (default: 0600, only clients of the same user can connect).
+ */
+template <typename DISPLAY>
+ssd1306_server_t<DISPLAY>::ssd1306_server_t(DISPLAY& display, const std::string& name, mode_t mode) :
+    display(display),
+    name(name),
+    shm(map_shm(name, true, mode))
+{
+    /* ftruncate() zeroes the memory, which is a valid state for every member. */
+    this->shm->width = DISPLAY::SCREEN_WIDTH;
+    this->shm->pages = DISPLAY::NUMBER_OF_PAGES;
+
+    for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS; i++)
+    {
+        for (size_t page = 0; page < ssd1306_shm_layer_t::MAX_PAGES; page++)
+        {
+            this->shm->layers[i].damage[page] = ssd1306_shm_layer_t::CLEAN;
+        }
+    }
+
+    /* Clients check the magic number, so it is written last. */
+    std::atomic_thread_fence(std::memory_order_release);
+    this->shm->magic = ssd1306_shm_t::MAGIC;
+}
+
+/**
+ * @brief Destroy the ssd1306_server_t object and remove its shared memory. Mapped clients keep their memory.
+ */
+template <typename DISPLAY>
+ssd1306_server_t<DISPLAY>::~ssd1306_server_t()
+{
+    munmap(this->shm, sizeof(ssd1306_shm_t));
+    shm_unlink(this->name.c_str());
+}
+
+/**
+ * @brief Composite all damage of the layers into the framebuffer and flush it.
+ *
+ * @return true if there was damage.
+ */
+template <typename DISPLAY>
+bool ssd1306_server_t<DISPLAY>::process()
+{
+    uint8_t* framebuffer = this->display.get_framebuffer();
+    uint8_t order[ssd1306_shm_t::MAX_LAYERS];
+    uint8_t count = 0u;
+    bool damaged = false;
+
+    this->reap_layers();
+
+    /* Visible layers from bottom to top. */
+    for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS; i++)
+    {
+        if (this->shm->layers[i].owner != 0u && this->shm->layers[i].visible)
+        {
+            order[count++] = i;
+        }
+    }
+
+    std::stable_sort(order, order + count, [this](uint8_t a, uint8_t b) { return this->shm->layers[a].z < this->shm->layers[b].z; });
+
+    for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+    {
+        uint8_t column_start = DISPLAY::SCREEN_WIDTH;
+        uint8_t column_end = 0u;
+
+        /* Take the damage of every layer, also of layers that were just hidden or released. */
+        for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS; i++)
+        {
+            const uint16_t damage = this->shm->layers[i].damage[page].exchange(ssd1306_shm_layer_t::CLEAN);
+
+            if (damage != ssd1306_shm_layer_t::CLEAN)
+            {
+                column_start = std::min<uint8_t>(column_start, damage & 0xFFu);
+                column_end = std::max<uint8_t>(column_end, damage >> 8u);
+            }
+        }
+
+        if (column_start > column_end)
+        {
+            continue;
+        }
+
+        for (size_t column = column_start; column <= column_end; column++)
+        {
+            const size_t index = page * DISPLAY::SCREEN_WIDTH + column;
+            uint8_t pixels = 0u;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const ssd1306_shm_layer_t& layer = this->shm->layers[order[i]];
+
+                pixels = (pixels & ~layer.mask[index]) | (layer.pixels[index] & layer.mask[index]);
+            }
+
+            framebuffer[index] = pixels;
+        }
+
+        this->display.mark_dirty(column_start, page, column_end, page);
+        damaged = true;
+    }
+
+    this->display.flush();
+
+    return damaged;
+}
+
+/**
+ * @brief Sleep until a client posts damage.
+ *
+ * @param timeout Maximum time to sleep.
+ * @return true if there is damage to process.
+ */
+template <typename DISPLAY>
+bool ssd1306_server_t<DISPLAY>::wait(std::chrono::milliseconds timeout)
+{
+    this->shm->server_waiting = 1u;
+
+    const uint32_t sequence = this->shm->damage_sequence;
+    bool damaged = false;
+
+    for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS && !damaged; i++)
+    {
+        for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+        {
+            damaged |= this->shm->layers[i].damage[page] != ssd1306_shm_layer_t::CLEAN;
+        }
+    }
+
+    if (!damaged)
+    {
+        futex_wait(&this->shm->damage_sequence, sequence, timeout);
+        damaged = this->shm->damage_sequence != sequence;
+    }
+
+    this->shm->server_waiting = 0u;
+
+    return damaged;
+}
+
+/**
+ * @brief Serve the clients until stop is set.
+ * The timeout of the wait makes sure that stop and released layers are noticed.
+ *
+ * @param stop Flag to stop the server.
+ */
+template <typename DISPLAY>
+void ssd1306_server_t<DISPLAY>::run(const std::atomic<bool>& stop)
+{
+    while (!stop)
+    {
+        this->wait(std::chrono::milliseconds(100));
+        this->process();
+    }
+}
+
+/**
+ * @brief Release the layers of clients that exited without releasing them.
+ */
+template <typename DISPLAY>
+void ssd1306_server_t<DISPLAY>::reap_layers()
+{
+    for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS; i++)
+    {
+        ssd1306_shm_layer_t& layer = this->shm->layers[i];
+        uint32_t owner = layer.owner;
+
+        if (owner != 0u && kill(owner, 0) == -1 && errno == ESRCH)
+        {
+            layer.visible = 0u;
+
+            for (size_t page = 0; page < DISPLAY::NUMBER_OF_PAGES; page++)
+            {
+                merge_damage(layer.damage[page], 0u, DISPLAY::SCREEN_WIDTH - 1u);
+            }
+
+            layer.owner.compare_exchange_strong(owner, 0u);
+        }
+    }
+}
+
+/**
+ * @brief Construct a new ssd1306_client_t object and claim a layer of the display server.
+ * The layer starts empty (nothing covered) and visible.
+ *
+ * @param name Name of the shared memory object of the server (default: "/ssd1306").
+ * @param z Stacking order of the layer, higher is on top (default: 0).
+ */
+ssd1306_client_t::ssd1306_client_t(const std::string& name, uint8_t z) :
+    shm(map_shm(name, false)),
+    layer(nullptr)
+{
+    if (this->shm->magic != ssd1306_shm_t::MAGIC)
+    {
+        munmap(this->shm, sizeof(ssd1306_shm_t));
+        throw ssd1306_server_exception(name + " is not the shared memory of a display server");
+    }
+
+    for (size_t i = 0; i < ssd1306_shm_t::MAX_LAYERS && this->layer == nullptr; i++)
+    {
+        uint32_t free = 0u;
+
+        if (this->shm->layers[i].owner.compare_exchange_strong(free, getpid()))
+        {
+            this->layer = &this->shm->layers[i];
+        }
+    }
+
+    if (this->layer == nullptr)
+    {
+        munmap(this->shm, sizeof(ssd1306_shm_t));
+        throw ssd1306_server_exception("no free layer on " + name);
+    }
+
+    memset(this->layer->pixels, 0, sizeof(this->layer->pixels));
+    memset(this->layer->mask, 0, sizeof(this->layer->mask));
+    this->layer->z = z;
+    this->layer->visible = 1u;
+}
+
+/**
+ * @brief Destroy the ssd1306_client_t object. The layer is hidden, its area redrawn and the layer released.
+ */
+ssd1306_client_t::~ssd1306_client_t()
+{
+    this->layer->visible = 0u;
+    this->damage();
+    this->layer->owner = 0u;
+
+    munmap(this->shm, sizeof(ssd1306_shm_t));
+}
+
+/**
+ * @brief Get the page-major pixels of the layer. Rows are get_width() bytes long.
+ *
+ * @return uint8_t* Pixels of the layer.
+ */
+uint8_t* ssd1306_client_t::get_pixels()
+{
+    return this->layer->pixels;
+}
+
+/**
+ * @brief Get the page-major mask of the layer. Pixels with a cleared mask bit show the layers below.
+ *
+ * @return uint8_t* Mask of the layer.
+ */
+uint8_t* ssd1306_client_t::get_mask()
+{
+    return this->layer->mask;
+}
+
+/**
+ * @brief Get the width of the display.
+ *
+ * @return uint8_t Width in columns.
+ */
+uint8_t ssd1306_client_t::get_width()
+{
+    return this->shm->width;
+}
+
+/**
+ * @brief Get the number of pages of the display.
+ *
+ * @return uint8_t Number of pages.
+ */
+uint8_t ssd1306_client_t::get_pages()
+{
+    return this->shm->pages;
+}
+
+/**
+ * @brief Show or hide the layer.
+ *
+ * @param visible True to show the layer.
+ */
+void ssd1306_client_t::set_visible(bool visible)
+{
+    this->layer->visible = visible;
+    this->damage();
+}
+
+/**
+ * @brief Change the stacking order of the layer.
+ *
+ * @param z New stacking order, higher is on top.
+ */
+void ssd1306_client_t::set_z(uint8_t z)
+{
+    this->layer->z = z;
+    this->damage();
+}
+
+/**
+ * @brief Tell the server that a rectangle of the layer changed. Ends beyond the display are clipped.
+ *
+ * @param column_start First changed column.
+ * @param page_start First changed page.
+ * @param column_end Last changed column (default: the last column).
+ * @param page_end Last changed page (default: the last page).
+ */
+void ssd1306_client_t::damage(uint8_t column_start, uint8_t page_start, uint8_t column_end, uint8_t page_end)
+{
+    column_end = std::min<uint8_t>(column_end, this->shm->width - 1u);
+    page_end = std::min<uint8_t>(page_end, this->shm->pages - 1u);
+
+    assert(column_start <= column_end && page_start <= page_end);
+
+    for (size_t page = page_start; page <= page_end; page++)
+    {
+        merge_damage(this->layer->damage[page], column_start, column_end);
+    }
+
+    this->notify();
+}
+
+/**
+ * @brief Notify the server of new damage. Only costs a system call if the server sleeps.
+ */
+void ssd1306_client_t::notify()
+{
+    this->shm->damage_sequence++;
+
+    if (this->shm->server_waiting)
+    {
+        futex_wake(&this->shm->damage_sequence);
+    }
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_server_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_server_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_server_t<ssd1306_96x16_t>;
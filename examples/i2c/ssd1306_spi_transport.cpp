@@ -0,0 +1,110 @@
+/**
+ * @file ssd1306_spi_transport.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the SPI transport of the SSD1306 driver.
+ * @date 18-10-2026
+ *
+ * In 4-wire SPI mode the controller samples the D/C pin together with the last bit of every byte:
+ * low means the byte is a command, high means it is written to the GDDRAM.
+ * The pin is only toggled when the kind of write changes, so a frame costs one GPIO write and one SPI ioctl.
+ * A full frame is at most 1024 bytes, which spi_device_t sends as a single multi-transfer SPI_IOC_MESSAGE.
+ * The controller can not be read over SPI (see page 21 of the data sheet).
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "include/ssd1306_spi_transport.hpp"
+#include "../../src/spi/include/spi_exception.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new ssd1306_spi_transport_t object.
+ *
+ * @param device SPI device of the display.
+ * @param dc_pin GPIO pin connected to D/C.
+ * @param reset_pin GPIO pin connected to RES.
+ */
+ssd1306_spi_transport_t::ssd1306_spi_transport_t(spi_device_t& device, gpio_pin_t& dc_pin, gpio_pin_t& reset_pin) :
+    device(device),
+    dc_pin(dc_pin),
+    reset_pin(reset_pin)
+{}
+
+/**
+ * @brief Open the SPI device, request the D/C and reset pins as outputs and reset the controller.
+ */
+void ssd1306_spi_transport_t::initialise()
+{
+    gpio_config_t dc_config;
+    gpio_config_t reset_config;
+
+    if (this->device.initialised == 0u)
+    {
+        this->device.initialise();
+    }
+
+    dc_config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+    dc_config.output_value = GPIO_STATE_LOW;
+    reset_config.direction = GPIOD_LINE_DIRECTION_OUTPUT;
+    reset_config.output_value = GPIO_STATE_HIGH;
+
+    this->dc_pin.initialise(dc_config, "ssd1306 d/c");
+    this->reset_pin.initialise(reset_config, "ssd1306 reset");
+
+    this->reset();
+}
+
+/**
+ * @brief Reset the controller with the RES pin. All registers go back to their reset values.
+ */
+void ssd1306_spi_transport_t::reset()
+{
+    /* RES must be low for at least 3 us (page 27 of the data sheet). */
+    this->reset_pin.set_value(GPIO_STATE_LOW);
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+    this->reset_pin.set_value(GPIO_STATE_HIGH);
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+}
+
+/**
+ * @brief Write commands to the display in a single SPI write.
+ *
+ * @param commands Command bytes to write.
+ * @param size Number of command bytes.
+ */
+void ssd1306_spi_transport_t::write_commands(const uint8_t* commands, uint16_t size)
+{
+    /* The D/C pin keeps its value between writes, so it is only written when it changes. */
+    this->dc_pin.set_value(GPIO_STATE_LOW);
+    this->device.spi_write(commands, size);
+}
+
+/**
+ * @brief Write data bytes to the GDDRAM in a single SPI write.
+ *
+ * @param data Data bytes to write.
+ * @param size Number of data bytes.
+ */
+void ssd1306_spi_transport_t::write_data(const uint8_t* data, uint16_t size)
+{
+    this->dc_pin.set_value(GPIO_STATE_HIGH);
+    this->device.spi_write(data, size);
+}
+
+/**
+ * @brief The status register can not be read over SPI.
+ */
+uint8_t ssd1306_spi_transport_t::read_status()
+{
+    throw spi_transfer_exception("the SSD1306 can not be read over SPI");
+}
+
+/**
+ * @brief The GDDRAM can not be read over SPI.
+ */
+uint8_t ssd1306_spi_transport_t::read_data()
+{
+    throw spi_transfer_exception("the SSD1306 can not be read over SPI");
+}
@@ -0,0 +1,306 @@
+/**
+ * @file ssd1306_sprite.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Sprites with pre-shifted copies, and drawing them into the framebuffer of ssd1306_t.
+ * @date 18-10-2026
+ *
+ * A pixel at row y is bit y % 8 of page y / 8, so drawing a sprite at an arbitrary y normally shifts every column
+ * of it over two pages. A sprite stores the result of that shift for all 8 possible offsets, so a draw is one
+ * AND and one OR per framebuffer byte: (framebuffer & ~mask) | pixels. The masks also make collision detection
+ * a matter of ANDing bytes.
+ */
+
+#include <algorithm>
+#include <assert.h>
+
+#include "include/ssd1306_sprite.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Split a y coordinate into the page of the top of a sprite and the shift within that page.
+ * Works for negative coordinates, e.g. -3 is page -1 with shift 5.
+ *
+ * @param y Y coordinate.
+ * @param page First page of the sprite.
+ * @param shift Shift variant to use.
+ */
+static void split_y(int16_t y, int16_t& page, uint8_t& shift)
+{
+    shift = y & 7;
+    page = (y - shift) / 8;
+}
+
+/**
+ * @brief Construct a new ssd1306_sprite_t object and precompute its shift variants.
+ *
+ * @param width Width of the sprite.
+ * @param height Height of the sprite.
+ * @param pixels Row-major pixels (0 or 1) of the sprite.
+ * @param mask Row-major mask, 1 where the sprite covers what is below it. If not given, the sprite covers
+ *             only its pixels that are on, so the rest is transparent.
+ */
+ssd1306_sprite_t::ssd1306_sprite_t(uint8_t width, uint8_t height, const uint8_t* pixels, const uint8_t* mask) :
+    width(width),
+    height(height),
+    variant_pages((height + 7u + 7u) / 8u),
+    pixels(SHIFTS * variant_pages * width, 0u),
+    mask(SHIFTS * variant_pages * width, 0u)
+{
+    assert(width > 0u && height > 0u);
+
+    for (size_t shift = 0; shift < SHIFTS; shift++)
+    {
+        const size_t variant = shift * this->variant_pages * width;
+
+        for (size_t y = 0; y < height; y++)
+        {
+            const size_t row = variant + (y + shift) / 8u * width;
+            const uint8_t bit = 1u << ((y + shift) % 8u);
+
+            for (size_t x = 0; x < width; x++)
+            {
+                const bool covered = mask != nullptr ? mask[y * width + x] : pixels[y * width + x];
+
+                if (covered)
+                {
+                    this->mask[row + x] |= bit;
+
+                    if (pixels[y * width + x])
+                    {
+                        this->pixels[row + x] |= bit;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the width of the sprite.
+ *
+ * @return uint8_t Width in columns.
+ */
+uint8_t ssd1306_sprite_t::get_width() const
+{
+    return this->width;
+}
+
+/**
+ * @brief Get the height of the sprite.
+ *
+ * @return uint8_t Height in rows.
+ */
+uint8_t ssd1306_sprite_t::get_height() const
+{
+    return this->height;
+}
+
+/**
+ * @brief Get the number of pages that a shift variant spans.
+ *
+ * @param shift Shift (0-7).
+ * @return uint8_t Number of pages.
+ */
+uint8_t ssd1306_sprite_t::get_pages(uint8_t shift) const
+{
+    assert(shift < SHIFTS);
+
+    return (this->height + shift + 7u) / 8u;
+}
+
+/**
+ * @brief Get the pixels of a shift variant: get_pages(shift) rows of get_width() columns, already masked.
+ *
+ * @param shift Shift (0-7).
+ * @return const uint8_t* Page-major pixels.
+ */
+const uint8_t* ssd1306_sprite_t::get_pixels(uint8_t shift) const
+{
+    assert(shift < SHIFTS);
+
+    return this->pixels.data() + shift * this->variant_pages * this->width;
+}
+
+/**
+ * @brief Get the mask of a shift variant, same layout as the pixels.
+ *
+ * @param shift Shift (0-7).
+ * @return const uint8_t* Page-major mask.
+ */
+const uint8_t* ssd1306_sprite_t::get_mask(uint8_t shift) const
+{
+    assert(shift < SHIFTS);
+
+    return this->mask.data() + shift * this->variant_pages * this->width;
+}
+
+/**
+ * @brief Check whether the masks of two sprites overlap, pixel exact.
+ *
+ * @param x X coordinate of this sprite.
+ * @param y Y coordinate of this sprite.
+ * @param other Other sprite.
+ * @param other_x X coordinate of the other sprite.
+ * @param other_y Y coordinate of the other sprite.
+ * @return true if at least one pixel is covered by both sprites.
+ */
+bool ssd1306_sprite_t::collides(int16_t x, int16_t y, const ssd1306_sprite_t& other, int16_t other_x, int16_t other_y) const
+{
+    const int16_t column_start = std::max(x, other_x);
+    const int16_t column_end = std::min(x + this->width, other_x + other.width);
+    int16_t page;
+    int16_t other_page;
+    uint8_t shift;
+    uint8_t other_shift;
+
+    if (column_start >= column_end)
+    {
+        return false;
+    }
+
+    split_y(y, page, shift);
+    split_y(other_y, other_page, other_shift);
+
+    const uint8_t* mask = this->get_mask(shift);
+    const uint8_t* other_mask = other.get_mask(other_shift);
+
+    for (int16_t p = 0; p < this->get_pages(shift); p++)
+    {
+        const int16_t other_p = page + p - other_page;
+
+        if (other_p < 0 || other_p >= other.get_pages(other_shift))
+        {
+            continue;
+        }
+
+        for (int16_t column = column_start; column < column_end; column++)
+        {
+            if (mask[p * this->width + column - x] & other_mask[other_p * other.width + column - other_x])
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Construct a new ssd1306_sprite_engine_t object.
+ *
+ * @param display Display to draw on.
+ */
+template <typename DISPLAY>
+ssd1306_sprite_engine_t<DISPLAY>::ssd1306_sprite_engine_t(DISPLAY& display) :
+    display(display)
+{
+}
+
+/**
+ * @brief Draw a sprite into the framebuffer. The changes are written by the next flush of the display.
+ *
+ * @param sprite Sprite to draw.
+ * @param x X coordinate of the left of the sprite.
+ * @param y Y coordinate of the top of the sprite.
+ */
+template <typename DISPLAY>
+void ssd1306_sprite_engine_t<DISPLAY>::draw(const ssd1306_sprite_t& sprite, int16_t x, int16_t y)
+{
+    this->blit(sprite, x, y, true, [](uint8_t& byte, uint8_t pixels, uint8_t mask) {
+        byte = (byte & ~mask) | pixels;
+        return false;
+    });
+}
+
+/**
+ * @brief Erase a sprite from the framebuffer: turn off every pixel that its mask covers.
+ *
+ * @param sprite Sprite to erase.
+ * @param x X coordinate the sprite was drawn at.
+ * @param y Y coordinate the sprite was drawn at.
+ */
+template <typename DISPLAY>
+void ssd1306_sprite_engine_t<DISPLAY>::erase(const ssd1306_sprite_t& sprite, int16_t x, int16_t y)
+{
+    this->blit(sprite, x, y, true, [](uint8_t& byte, uint8_t, uint8_t mask) {
+        byte &= ~mask;
+        return false;
+    });
+}
+
+/**
+ * @brief Check whether the mask of a sprite covers any pixel that is on in the framebuffer,
+ * e.g. to detect a collision with the background before drawing.
+ *
+ * @param sprite Sprite to check.
+ * @param x X coordinate of the sprite.
+ * @param y Y coordinate of the sprite.
+ * @return true if the sprite would cover a pixel that is on.
+ */
+template <typename DISPLAY>
+bool ssd1306_sprite_engine_t<DISPLAY>::overlaps(const ssd1306_sprite_t& sprite, int16_t x, int16_t y)
+{
+    return this->blit(sprite, x, y, false, [](uint8_t& byte, uint8_t, uint8_t mask) {
+        return (byte & mask) != 0u;
+    });
+}
+
+/**
+ * @brief Apply an operation to every framebuffer byte under a sprite, clipped to the screen.
+ *
+ * @param sprite Sprite.
+ * @param x X coordinate of the sprite.
+ * @param y Y coordinate of the sprite.
+ * @param mark_dirty True to mark the bytes as dirty.
+ * @param operation Called with the framebuffer byte, the pixels and the mask. Returns true to stop.
+ * @return true if the operation stopped the blit.
+ */
+template <typename DISPLAY>
+template <typename OPERATION>
+bool ssd1306_sprite_engine_t<DISPLAY>::blit(const ssd1306_sprite_t& sprite, int16_t x, int16_t y, bool mark_dirty, OPERATION operation)
+{
+    uint8_t* framebuffer = this->display.get_framebuffer();
+    int16_t page;
+    uint8_t shift;
+
+    split_y(y, page, shift);
+
+    const int16_t column_start = std::max<int16_t>(x, 0);
+    const int16_t column_end = std::min<int16_t>(x + sprite.get_width(), DISPLAY::SCREEN_WIDTH);
+    const int16_t page_start = std::max<int16_t>(page, 0);
+    const int16_t page_end = std::min<int16_t>(page + sprite.get_pages(shift), DISPLAY::NUMBER_OF_PAGES);
+    const uint8_t* pixels = sprite.get_pixels(shift);
+    const uint8_t* mask = sprite.get_mask(shift);
+
+    if (column_start >= column_end || page_start >= page_end)
+    {
+        return false;
+    }
+
+    if (mark_dirty)
+    {
+        this->display.mark_dirty(column_start, page_start, column_end - 1, page_end - 1);
+    }
+
+    for (int16_t p = page_start; p < page_end; p++)
+    {
+        uint8_t* row = framebuffer + p * DISPLAY::SCREEN_WIDTH;
+        const int32_t sprite_row = (p - page) * sprite.get_width() - x;
+
+        for (int16_t column = column_start; column < column_end; column++)
+        {
+            if (operation(row[column], pixels[sprite_row + column], mask[sprite_row + column]))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/* Supported panels. */
+template class pi_zero_peripherals::ssd1306_sprite_engine_t<ssd1306_128x32_t>;
+template class pi_zero_peripherals::ssd1306_sprite_engine_t<ssd1306_128x64_t>;
+template class pi_zero_peripherals::ssd1306_sprite_engine_t<ssd1306_96x16_t>;
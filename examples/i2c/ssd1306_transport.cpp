@@ -0,0 +1,159 @@
+/**
+ * @file ssd1306_transport.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the I2C transport of the SSD1306 driver.
+ * @date 18-10-2026
+ *
+ * After sending the slave address, we need to send
+ * a control byte <Co, D/C, 0, 0, 0, 0, 0, 0>.
+ * - If Co == 0, all following bytes are data bytes.
+ * - If Co == 1, following bytes may contain control bytes.
+ * - If D/C == 0, all following data bytes are a command.
+ * - If D/C == 1, all following data bytes are written to the GDDRAM.
+ *
+ * The control byte has to come right before the data in the same message. write_data() copies the data behind a
+ * control byte. write_data_in_place() needs a byte of headroom in front of the data instead (the framebuffer of
+ * ssd1306_t has one), which is temporarily replaced by the control byte, so the data is sent without any copy.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "include/ssd1306_transport.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Write data bytes to the GDDRAM that have a byte of headroom in front of them.
+ * Transports that do not need the headroom just write the data.
+ *
+ * @param data Data bytes to write. data[-1] must be writable, it is restored before returning.
+ * @param size Number of data bytes.
+ */
+void ssd1306_transport_t::write_data_in_place(uint8_t* data, uint16_t size)
+{
+    this->write_data(data, size);
+}
+
+/**
+ * @brief Construct a new ssd1306_i2c_transport_t object.
+ *
+ * @param bus I2C bus that the device is on.
+ * @param address_lsb LSB of the slave address. Can be 0 or 1 depending on the SA0 pin.
+ */
+ssd1306_i2c_transport_t::ssd1306_i2c_transport_t(i2c_bus_t& bus, uint8_t address_lsb) :
+    i2c_device_t(bus, ADDRESS_BASE | address_lsb)
+{}
+
+/**
+ * @brief Initialise the I2C bus, unless another device on the bus already did.
+ */
+void ssd1306_i2c_transport_t::initialise()
+{
+    if (this->bus.initialised == 0u)
+    {
+        this->bus.initialise();
+    }
+}
+
+/**
+ * @brief Write commands to the display. Each command byte is sent in its own message, like the original driver did.
+ *
+ * @param commands Command bytes to write.
+ * @param size Number of command bytes.
+ */
+void ssd1306_i2c_transport_t::write_commands(const uint8_t* commands, uint16_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        uint8_t buffer[2] = { COMMAND_BYTE, commands[i] };
+
+        this->i2c_write(buffer, 2u);
+    }
+}
+
+/**
+ * @brief Write data bytes to the GDDRAM, in messages of at most MAX_MESSAGE_SIZE data bytes.
+ *
+ * @param data Data bytes to write.
+ * @param size Number of data bytes.
+ */
+void ssd1306_i2c_transport_t::write_data(const uint8_t* data, uint16_t size)
+{
+    uint8_t buffer[1u + MAX_MESSAGE_SIZE];
+
+    buffer[0] = DATA_BYTE;
+
+    for (uint16_t written = 0u; written < size; written += MAX_MESSAGE_SIZE)
+    {
+        const uint16_t chunk = size - written < MAX_MESSAGE_SIZE ? size - written : MAX_MESSAGE_SIZE;
+
+        memcpy(&buffer[1], data + written, chunk);
+
+        this->i2c_write_message(buffer, chunk + 1u);
+    }
+}
+
+/**
+ * @brief Write data bytes to the GDDRAM without copying them, in messages of at most MAX_MESSAGE_SIZE data bytes.
+ * The byte in front of each message is patched with the control byte and restored after the message is sent.
+ *
+ * @param data Data bytes to write. data[-1] must be writable, it is restored before returning.
+ * @param size Number of data bytes.
+ */
+void ssd1306_i2c_transport_t::write_data_in_place(uint8_t* data, uint16_t size)
+{
+    for (uint16_t written = 0u; written < size; written += MAX_MESSAGE_SIZE)
+    {
+        const uint16_t chunk = size - written < MAX_MESSAGE_SIZE ? size - written : MAX_MESSAGE_SIZE;
+        uint8_t* message = data + written - 1u;
+        const uint8_t saved = *message;
+
+        *message = DATA_BYTE;
+
+        try
+        {
+            this->i2c_write_message(message, chunk + 1u);
+        }
+        catch (...)
+        {
+            *message = saved;
+            throw;
+        }
+
+        *message = saved;
+    }
+}
+
+/**
+ * @brief Read the status register of the controller.
+ *
+ * @return uint8_t Status register.
+ */
+uint8_t ssd1306_i2c_transport_t::read_status()
+{
+    uint8_t result;
+    uint8_t command[1] = { COMMAND_BYTE };
+
+    this->i2c_write(command, 1u);
+    this->i2c_read(&result, 1u);
+
+    return result;
+}
+
+/**
+ * @brief Read a data byte from the GDDRAM.
+ *
+ * @return uint8_t Data that was read.
+ */
+uint8_t ssd1306_i2c_transport_t::read_data()
+{
+    uint8_t data[1] = { DATA_BYTE };
+
+    this->i2c_write(data, 1u);
+    /* Dummy read. */
+    this->i2c_read(data, 1u);
+    this->i2c_read(data, 1u);
+
+    return *data;
+}
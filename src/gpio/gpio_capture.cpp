@@ -0,0 +1,316 @@
+/**
+ * @file gpio_capture.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the implementation for the gpio_capture and gpio_pulse_analyzer classes.
+ *        The timestamps are taken by the kernel when the edge interrupt fires, so they do not contain the wakeup
+ *        latency of the capture thread. The capture thread reads up to 16 queued events per system call and
+ *        hands them to the consumer through a single-producer single-consumer ring, so a slow consumer never
+ *        blocks the capture; when the ring is full, events are dropped and counted.
+ * @date 18-10-2026
+ */
+
+#include <algorithm>
+#include <assert.h>
+
+#include "include/gpio_capture.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Time the capture thread waits for an edge before checking whether it must stop. */
+static constexpr std::chrono::milliseconds CAPTURE_POLL_INTERVAL(100);
+
+/**
+ * @brief Construct a new gpio_capture_t object.
+ *
+ * @param pin GPIO pin, must be initialised with an event.
+ * @param capacity Number of events the ring buffer holds, must be a power of two.
+ */
+gpio_capture_t::gpio_capture_t(gpio_pin_t& pin, uint32_t capacity) :
+    pin(pin),
+    ring(capacity),
+    mask(capacity - 1u),
+    head(0u),
+    tail(0u),
+    captured(0u),
+    dropped(0u),
+    running(false)
+{
+    /* Capacity must be a power of two. */
+    assert(capacity > 0u && (capacity & (capacity - 1u)) == 0u);
+}
+
+/**
+ * @brief Destroy a gpio_capture_t object. Stops the capture thread.
+ */
+gpio_capture_t::~gpio_capture_t()
+{
+    this->stop();
+}
+
+/**
+ * @brief Start the capture thread.
+ */
+void gpio_capture_t::start()
+{
+    /* Capture must not be running yet. */
+    assert(!this->running);
+
+    this->running = true;
+    this->thread = std::thread(&gpio_capture_t::capture, this);
+}
+
+/**
+ * @brief Stop the capture thread. Events that were captured can still be popped.
+ */
+void gpio_capture_t::stop()
+{
+    this->running = false;
+
+    if (this->thread.joinable())
+    {
+        this->thread.join();
+    }
+}
+
+/**
+ * @brief Take the oldest captured event.
+ *
+ * @param event Event that is taken.
+ * @return true if there was an event.
+ */
+bool gpio_capture_t::pop(gpio_event_t& event)
+{
+    return this->pop(&event, 1u) == 1u;
+}
+
+/**
+ * @brief Take the oldest captured events.
+ *
+ * @param events Array for the events that are taken.
+ * @param count Maximum number of events to take.
+ * @return uint32_t Number of events taken.
+ */
+uint32_t gpio_capture_t::pop(gpio_event_t* events, uint32_t count)
+{
+    const uint32_t head = this->head.load(std::memory_order_relaxed);
+    const uint32_t available = this->tail.load(std::memory_order_acquire) - head;
+    const uint32_t taken = std::min(available, count);
+
+    for (uint32_t i = 0; i < taken; i++)
+    {
+        events[i] = this->ring[(head + i) & this->mask];
+    }
+
+    this->head.store(head + taken, std::memory_order_release);
+
+    return taken;
+}
+
+/**
+ * @brief Get the number of events that were put into the ring.
+ *
+ * @return uint64_t Number of captured events.
+ */
+uint64_t gpio_capture_t::get_captured()
+{
+    return this->captured;
+}
+
+/**
+ * @brief Get the number of events that were dropped because the ring was full.
+ *
+ * @return uint64_t Number of dropped events.
+ */
+uint64_t gpio_capture_t::get_dropped()
+{
+    return this->dropped;
+}
+
+/**
+ * @brief Body of the capture thread: wait for edges and put their events into the ring.
+ */
+void gpio_capture_t::capture()
+{
+    std::vector<gpio_event_t> events;
+
+    while (this->running)
+    {
+        if (!this->pin.wait_event(CAPTURE_POLL_INTERVAL))
+        {
+            continue;
+        }
+
+        events.clear();
+        this->pin.read_events(events);
+
+        uint32_t tail = this->tail.load(std::memory_order_relaxed);
+        const uint32_t head = this->head.load(std::memory_order_acquire);
+        uint32_t stored = 0u;
+
+        for (const gpio_event_t& event : events)
+        {
+            if (tail - head == this->ring.size())
+            {
+                break;
+            }
+
+            this->ring[tail & this->mask] = event;
+            tail++;
+            stored++;
+        }
+
+        this->tail.store(tail, std::memory_order_release);
+        this->captured += stored;
+        this->dropped += events.size() - stored;
+    }
+}
+
+/**
+ * @brief Construct a new gpio_pulse_analyzer_t object.
+ *
+ * @param window Cycles that ended longer ago than this, relative to the newest edge or the time passed to advance(),
+ * are not measured.
+ */
+gpio_pulse_analyzer_t::gpio_pulse_analyzer_t(std::chrono::nanoseconds window) :
+    window(window)
+{
+    this->reset();
+}
+
+/**
+ * @brief Add an edge. Edges must be added in the order they happened.
+ *
+ * @param event Edge event.
+ */
+void gpio_pulse_analyzer_t::add(const gpio_event_t& event)
+{
+    this->advance(event.timestamp);
+
+    if (event.edge == GPIO_EVENT_FALLING_EDGE)
+    {
+        if (this->seen_rising)
+        {
+            this->last_pulse_width = event.timestamp - this->last_rising;
+            this->seen_falling = true;
+        }
+
+        return;
+    }
+
+    if (this->seen_rising)
+    {
+        const cycle_t cycle = {
+            this->last_rising,
+            event.timestamp - this->last_rising,
+            this->seen_falling ? this->last_pulse_width : std::chrono::nanoseconds(0)
+        };
+
+        this->cycles.push_back(cycle);
+        this->period_sum += cycle.period;
+        this->high_time_sum += cycle.high_time;
+    }
+
+    this->seen_rising = true;
+    this->seen_falling = false;
+    this->last_rising = event.timestamp;
+}
+
+/**
+ * @brief Move the window to a point in time without an edge, e.g. before reading the measurements,
+ * so that cycles of a signal that stopped are no longer measured. Times must not go back.
+ *
+ * @param now Current time of CLOCK_MONOTONIC, the clock of the event timestamps.
+ */
+void gpio_pulse_analyzer_t::advance(std::chrono::nanoseconds now)
+{
+    /* Forget the cycles that ended before the window. */
+    while (!this->cycles.empty() && this->cycles.front().start + this->cycles.front().period < now - this->window)
+    {
+        this->period_sum -= this->cycles.front().period;
+        this->high_time_sum -= this->cycles.front().high_time;
+        this->cycles.pop_front();
+    }
+
+    /* A cycle that started before the window would be longer than the window, so the signal stopped in between.
+       Measuring starts again at the next rising edge. */
+    if (this->seen_rising && this->last_rising < now - this->window)
+    {
+        this->seen_rising = false;
+        this->seen_falling = false;
+    }
+}
+
+/**
+ * @brief Forget all edges, e.g. after events were dropped.
+ */
+void gpio_pulse_analyzer_t::reset()
+{
+    this->cycles.clear();
+    this->period_sum = std::chrono::nanoseconds(0);
+    this->high_time_sum = std::chrono::nanoseconds(0);
+    this->seen_rising = false;
+    this->seen_falling = false;
+    this->last_rising = std::chrono::nanoseconds(0);
+    this->last_pulse_width = std::chrono::nanoseconds(0);
+}
+
+/**
+ * @brief Get the number of complete cycles in the window.
+ *
+ * @return uint32_t Number of cycles.
+ */
+uint32_t gpio_pulse_analyzer_t::get_cycles()
+{
+    return this->cycles.size();
+}
+
+/**
+ * @brief Get the width of the last high pulse, also if it is not part of a complete cycle yet,
+ * e.g. for an ultrasonic echo or a single IR pulse.
+ *
+ * @return std::chrono::nanoseconds Width of the last pulse, 0 if there was none.
+ */
+std::chrono::nanoseconds gpio_pulse_analyzer_t::get_last_pulse_width()
+{
+    return this->last_pulse_width;
+}
+
+/**
+ * @brief Get the mean width of the high pulses in the window.
+ *
+ * @return std::chrono::nanoseconds Mean pulse width, 0 without cycles.
+ */
+std::chrono::nanoseconds gpio_pulse_analyzer_t::get_pulse_width()
+{
+    return this->cycles.empty() ? std::chrono::nanoseconds(0) : this->high_time_sum / (int64_t)this->cycles.size();
+}
+
+/**
+ * @brief Get the mean period in the window.
+ *
+ * @return std::chrono::nanoseconds Mean period, 0 without cycles.
+ */
+std::chrono::nanoseconds gpio_pulse_analyzer_t::get_period()
+{
+    return this->cycles.empty() ? std::chrono::nanoseconds(0) : this->period_sum / (int64_t)this->cycles.size();
+}
+
+/**
+ * @brief Get the duty cycle in the window: the time the signal was high divided by the total time.
+ *
+ * @return double Duty cycle between 0 and 1, 0 without cycles or without falling edges.
+ */
+double gpio_pulse_analyzer_t::get_duty_cycle()
+{
+    return this->period_sum.count() == 0 ? 0.0 : (double)this->high_time_sum.count() / this->period_sum.count();
+}
+
+/**
+ * @brief Get the frequency in the window.
+ *
+ * @return double Frequency in Hz, 0 without cycles.
+ */
+double gpio_pulse_analyzer_t::get_frequency()
+{
+    return this->period_sum.count() == 0 ? 0.0 : 1e9 * this->cycles.size() / this->period_sum.count();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file gpio_event_loop.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the implementation for the gpio_event_loop class.
+ *        The event file descriptors of all pins are in one epoll instance. A wakeup handles every pin that is
+ *        ready, and reads all events queued for a pin with one read, so a burst of edges costs few system calls.
+ *        An eventfd is also in the epoll instance, so that stop() can wake up the loop.
+ * @date 18-10-2026
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "include/gpio_event_loop.hpp"
+#include "include/gpio_exception.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new gpio_event_loop_t object without pins.
+ */
+gpio_event_loop_t::gpio_event_loop_t() :
+    epoll_fd(epoll_create1(EPOLL_CLOEXEC)),
+    wake_fd(eventfd(0u, EFD_CLOEXEC | EFD_NONBLOCK)),
+    stopped(false)
+{
+    epoll_event event = {};
+
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+
+    if (this->epoll_fd == -1 || this->wake_fd == -1 || epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->wake_fd, &event) == -1)
+    {
+        /* The destructor does not run, so close what was opened. */
+        if (this->wake_fd != -1)
+        {
+            close(this->wake_fd);
+        }
+
+        if (this->epoll_fd != -1)
+        {
+            close(this->epoll_fd);
+        }
+
+        throw gpio_event_exception("Could not create event loop");
+    }
+}
+
+/**
+ * @brief Destroy a gpio_event_loop_t object. The pins stay requested.
+ */
+gpio_event_loop_t::~gpio_event_loop_t()
+{
+    close(this->wake_fd);
+    close(this->epoll_fd);
+}
+
+/**
+ * @brief Add a pin to the loop. The pin must be initialised with an event.
+ *
+ * @param pin GPIO pin.
+ * @param callback Called from run_once() or run() for every edge of the pin, in the order they happened.
+ */
+void gpio_event_loop_t::add(gpio_pin_t& pin, callback_t callback)
+{
+    this->registrations.emplace_back(new registration_t{ pin, callback });
+
+    epoll_event event = {};
+
+    event.events = EPOLLIN;
+    event.data.ptr = this->registrations.back().get();
+
+    if (epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, pin.get_event_fd(), &event) == -1)
+    {
+        this->registrations.pop_back();
+
+        throw gpio_event_exception("Could not add GPIO" + std::to_string(pin.get_pin_number()) + " to event loop");
+    }
+}
+
+/**
+ * @brief Remove a pin from the loop. Must not be called from a callback.
+ *
+ * @param pin GPIO pin that was added.
+ */
+void gpio_event_loop_t::remove(gpio_pin_t& pin)
+{
+    const auto registration = std::find_if(this->registrations.begin(), this->registrations.end(),
+                                           [&pin](const std::unique_ptr<registration_t>& r) { return &r->pin == &pin; });
+
+    assert(registration != this->registrations.end());
+
+    epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, pin.get_event_fd(), nullptr);
+    this->registrations.erase(registration);
+}
+
+/**
+ * @brief Wait for edges once and dispatch all events that are queued.
+ *
+ * @param timeout_ms Maximum time to wait in milliseconds, -1 to wait until there is an edge or stop() is called.
+ * @return uint32_t Number of events dispatched.
+ */
+uint32_t gpio_event_loop_t::run_once(int timeout_ms)
+{
+    epoll_event ready[MAX_READY];
+    uint32_t dispatched = 0u;
+    const int count = epoll_wait(this->epoll_fd, ready, MAX_READY, timeout_ms);
+
+    if (count == -1)
+    {
+        if (errno == EINTR)
+        {
+            return 0u;
+        }
+
+        throw gpio_event_exception("Could not wait for GPIO events");
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        registration_t* registration = static_cast<registration_t*>(ready[i].data.ptr);
+
+        /* Wakeup from stop(). */
+        if (registration == nullptr)
+        {
+            uint64_t value;
+
+            if (read(this->wake_fd, &value, sizeof(value)) == -1)
+            {
+                /* Already read by another wakeup. */
+            }
+
+            continue;
+        }
+
+        this->events.clear();
+        registration->pin.read_events(this->events);
+
+        for (const gpio_event_t& event : this->events)
+        {
+            registration->callback(event);
+        }
+
+        dispatched += this->events.size();
+    }
+
+    return dispatched;
+}
+
+/**
+ * @brief Dispatch events until stop() is called. Returns immediately if stop() was called before, until reset().
+ */
+void gpio_event_loop_t::run()
+{
+    while (!this->stopped)
+    {
+        this->run_once();
+    }
+}
+
+/**
+ * @brief Make run() return. Can be called from a callback or from another thread.
+ */
+void gpio_event_loop_t::stop()
+{
+    const uint64_t value = 1u;
+
+    this->stopped = true;
+
+    if (write(this->wake_fd, &value, sizeof(value)) == -1)
+    {
+        /* The counter is full, so the loop wakes up anyway. */
+    }
+}
+
+/**
+ * @brief Make run() dispatch events again after stop(). Must not be called while run() is running.
+ */
+void gpio_event_loop_t::reset()
+{
+    this->stopped = false;
+}
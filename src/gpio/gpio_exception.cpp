@@ -0,0 +1,28 @@
+/**
+ * @file gpio_exception.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains various exceptions for GPIO operations.
+ * @date 18-10-2026
+ */
+
+#include "include/gpio_exception.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new gpio_event_exception object. Used when waiting for edge events fails.
+ *
+ * @param message Error message.
+ */
+gpio_event_exception::gpio_event_exception(const std::string& message) :
+    runtime_error(message)
+{}
+
+/**
+ * @brief Construct a new gpio_register_exception object. Used when the GPIO registers cannot be mapped.
+ *
+ * @param message Error message.
+ */
+gpio_register_exception::gpio_register_exception(const std::string& message) :
+    runtime_error(message)
+{}
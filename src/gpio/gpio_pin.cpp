@@ -9,84 +9,203 @@
 #include <assert.h>
 
 #include "include/gpio_pin.hpp"
+#include "include/gpio_sim_chip.hpp"
 
 using namespace pi_zero_peripherals;
 
-/* Number of GPIO pins supported. */
-static constexpr uint8_t NUM_GPIO_PINS = 54u;
 /* Define default config. */
 static constexpr gpio_config_t DEFAULT_CONFIG;
 
-/* Define chip for gpiochip0. */
-static gpiod::chip gpiochip0("0", gpiod::chip::OPEN_BY_NUMBER);
+/* Backend of pins that are initialised with GPIO_BACKEND_DEFAULT. */
+static uint8_t default_backend = GPIO_BACKEND_CHARDEV;
+/* Registers used by the GPIO_BACKEND_GPIOMEM backend, mapped on first use unless set by gpio_set_registers(). */
+static gpio_registers_t* gpiomem_registers = nullptr;
+/* Chip used by the GPIO_BACKEND_SIMULATED backend. */
+static gpio_sim_chip_t* simulated_chip = nullptr;
+/* All bias flags of a line request. */
+static const std::bitset<32> BIAS_FLAGS = gpiod::line_request::FLAG_BIAS_DISABLE | gpiod::line_request::FLAG_BIAS_PULL_UP | gpiod::line_request::FLAG_BIAS_PULL_DOWN;
 
 /* Define GPIO pins. */
-gpio_pin_t GPIO0(0u);
-gpio_pin_t GPIO1(1u);
-gpio_pin_t GPIO2(2u);
-gpio_pin_t GPIO3(3u);
-gpio_pin_t GPIO4(4u);
-gpio_pin_t GPIO5(5u);
-gpio_pin_t GPIO6(6u);
-gpio_pin_t GPIO7(7u);
-gpio_pin_t GPIO8(8u);
-gpio_pin_t GPIO9(9u);
-gpio_pin_t GPIO10(10u);
-gpio_pin_t GPIO11(11u);
-gpio_pin_t GPIO12(12u);
-gpio_pin_t GPIO13(13u);
-gpio_pin_t GPIO14(14u);
-gpio_pin_t GPIO15(15u);
-gpio_pin_t GPIO16(16u);
-gpio_pin_t GPIO17(17u);
-gpio_pin_t GPIO18(18u);
-gpio_pin_t GPIO19(19u);
-gpio_pin_t GPIO20(20u);
-gpio_pin_t GPIO21(21u);
-gpio_pin_t GPIO22(22u);
-gpio_pin_t GPIO23(23u);
-gpio_pin_t GPIO24(24u);
-gpio_pin_t GPIO25(25u);
-gpio_pin_t GPIO26(26u);
-gpio_pin_t GPIO27(27u);
-gpio_pin_t GPIO28(28u);
-gpio_pin_t GPIO29(29u);
-gpio_pin_t GPIO30(30u);
-gpio_pin_t GPIO31(31u);
-gpio_pin_t GPIO32(32u);
-gpio_pin_t GPIO33(33u);
-gpio_pin_t GPIO34(34u);
-gpio_pin_t GPIO35(35u);
-gpio_pin_t GPIO36(36u);
-gpio_pin_t GPIO37(37u);
-gpio_pin_t GPIO38(38u);
-gpio_pin_t GPIO39(39u);
-gpio_pin_t GPIO40(40u);
-gpio_pin_t GPIO41(41u);
-gpio_pin_t GPIO42(42u);
-gpio_pin_t GPIO43(43u);
-gpio_pin_t GPIO44(44u);
-gpio_pin_t GPIO45(45u);
-gpio_pin_t GPIO46(46u);
-gpio_pin_t GPIO47(47u);
-gpio_pin_t GPIO48(48u);
-gpio_pin_t GPIO49(49u);
-gpio_pin_t GPIO50(50u);
-gpio_pin_t GPIO51(51u);
-gpio_pin_t GPIO52(52u);
-gpio_pin_t GPIO53(53u);
-
-/**
- * @brief Construct a new gpio_pin_t object.
+gpio_pin_t pi_zero_peripherals::GPIO0(0u);
+gpio_pin_t pi_zero_peripherals::GPIO1(1u);
+gpio_pin_t pi_zero_peripherals::GPIO2(2u);
+gpio_pin_t pi_zero_peripherals::GPIO3(3u);
+gpio_pin_t pi_zero_peripherals::GPIO4(4u);
+gpio_pin_t pi_zero_peripherals::GPIO5(5u);
+gpio_pin_t pi_zero_peripherals::GPIO6(6u);
+gpio_pin_t pi_zero_peripherals::GPIO7(7u);
+gpio_pin_t pi_zero_peripherals::GPIO8(8u);
+gpio_pin_t pi_zero_peripherals::GPIO9(9u);
+gpio_pin_t pi_zero_peripherals::GPIO10(10u);
+gpio_pin_t pi_zero_peripherals::GPIO11(11u);
+gpio_pin_t pi_zero_peripherals::GPIO12(12u);
+gpio_pin_t pi_zero_peripherals::GPIO13(13u);
+gpio_pin_t pi_zero_peripherals::GPIO14(14u);
+gpio_pin_t pi_zero_peripherals::GPIO15(15u);
+gpio_pin_t pi_zero_peripherals::GPIO16(16u);
+gpio_pin_t pi_zero_peripherals::GPIO17(17u);
+gpio_pin_t pi_zero_peripherals::GPIO18(18u);
+gpio_pin_t pi_zero_peripherals::GPIO19(19u);
+gpio_pin_t pi_zero_peripherals::GPIO20(20u);
+gpio_pin_t pi_zero_peripherals::GPIO21(21u);
+gpio_pin_t pi_zero_peripherals::GPIO22(22u);
+gpio_pin_t pi_zero_peripherals::GPIO23(23u);
+gpio_pin_t pi_zero_peripherals::GPIO24(24u);
+gpio_pin_t pi_zero_peripherals::GPIO25(25u);
+gpio_pin_t pi_zero_peripherals::GPIO26(26u);
+gpio_pin_t pi_zero_peripherals::GPIO27(27u);
+gpio_pin_t pi_zero_peripherals::GPIO28(28u);
+gpio_pin_t pi_zero_peripherals::GPIO29(29u);
+gpio_pin_t pi_zero_peripherals::GPIO30(30u);
+gpio_pin_t pi_zero_peripherals::GPIO31(31u);
+gpio_pin_t pi_zero_peripherals::GPIO32(32u);
+gpio_pin_t pi_zero_peripherals::GPIO33(33u);
+gpio_pin_t pi_zero_peripherals::GPIO34(34u);
+gpio_pin_t pi_zero_peripherals::GPIO35(35u);
+gpio_pin_t pi_zero_peripherals::GPIO36(36u);
+gpio_pin_t pi_zero_peripherals::GPIO37(37u);
+gpio_pin_t pi_zero_peripherals::GPIO38(38u);
+gpio_pin_t pi_zero_peripherals::GPIO39(39u);
+gpio_pin_t pi_zero_peripherals::GPIO40(40u);
+gpio_pin_t pi_zero_peripherals::GPIO41(41u);
+gpio_pin_t pi_zero_peripherals::GPIO42(42u);
+gpio_pin_t pi_zero_peripherals::GPIO43(43u);
+gpio_pin_t pi_zero_peripherals::GPIO44(44u);
+gpio_pin_t pi_zero_peripherals::GPIO45(45u);
+gpio_pin_t pi_zero_peripherals::GPIO46(46u);
+gpio_pin_t pi_zero_peripherals::GPIO47(47u);
+gpio_pin_t pi_zero_peripherals::GPIO48(48u);
+gpio_pin_t pi_zero_peripherals::GPIO49(49u);
+gpio_pin_t pi_zero_peripherals::GPIO50(50u);
+gpio_pin_t pi_zero_peripherals::GPIO51(51u);
+gpio_pin_t pi_zero_peripherals::GPIO52(52u);
+gpio_pin_t pi_zero_peripherals::GPIO53(53u);
+
+/**
+ * @brief Get gpiochip0. It is opened on the first call, so programs that do not use GPIO pins never open it.
+ *
+ * @return gpiod::chip& The chip.
+ */
+gpiod::chip& pi_zero_peripherals::gpio_chip()
+{
+    static gpiod::chip gpiochip0("0", gpiod::chip::OPEN_BY_NUMBER);
+
+    return gpiochip0;
+}
+
+/**
+ * @brief Get the flags of a line request for a bias.
+ *
+ * @param bias GPIOD_LINE_BIAS_AS_IS, GPIOD_LINE_BIAS_DISABLE, GPIOD_LINE_BIAS_PULL_UP or GPIOD_LINE_BIAS_PULL_DOWN.
+ * @return std::bitset<32> Flags, none for GPIOD_LINE_BIAS_AS_IS.
+ */
+std::bitset<32> pi_zero_peripherals::gpio_bias_flags(uint8_t bias)
+{
+    switch (bias)
+    {
+    case GPIOD_LINE_BIAS_DISABLE:
+        return gpiod::line_request::FLAG_BIAS_DISABLE;
+    case GPIOD_LINE_BIAS_PULL_UP:
+        return gpiod::line_request::FLAG_BIAS_PULL_UP;
+    case GPIOD_LINE_BIAS_PULL_DOWN:
+        return gpiod::line_request::FLAG_BIAS_PULL_DOWN;
+    default:
+        return 0u;
+    }
+}
+
+/**
+ * @brief Get the registers that pins with the GPIO_BACKEND_GPIOMEM backend use.
+ * /dev/gpiomem is mapped on the first call without other registers set, and stays mapped until the program exits,
+ * so pins that use it never see it unmapped.
+ *
+ * @return gpio_registers_t& The registers.
+ */
+gpio_registers_t& pi_zero_peripherals::gpio_registers()
+{
+    if (gpiomem_registers == nullptr)
+    {
+        static gpio_registers_t gpiomem;
+
+        gpiomem_registers = &gpiomem;
+    }
+
+    return *gpiomem_registers;
+}
+
+/**
+ * @brief Set the registers that pins with the GPIO_BACKEND_GPIOMEM backend use from now on,
+ * e.g. a file-backed stand-in in tests. Pins and ports keep the registers they were initialised with,
+ * so registers that are set must outlive the pins and ports that are initialised while they are set.
+ *
+ * @param registers The registers, nullptr to use /dev/gpiomem again.
+ */
+void pi_zero_peripherals::gpio_set_registers(gpio_registers_t* registers)
+{
+    gpiomem_registers = registers;
+}
+
+/**
+ * @brief Get the chip that pins with the GPIO_BACKEND_SIMULATED backend use. It must have been set.
+ *
+ * @return gpio_sim_chip_t& The chip.
+ */
+gpio_sim_chip_t& pi_zero_peripherals::gpio_sim_chip()
+{
+    assert(simulated_chip != nullptr);
+
+    return *simulated_chip;
+}
+
+/**
+ * @brief Set the chip that pins with the GPIO_BACKEND_SIMULATED backend use from now on.
+ * Pins keep the chip they were initialised with.
+ *
+ * @param sim_chip The chip.
+ */
+void pi_zero_peripherals::gpio_set_sim_chip(gpio_sim_chip_t* sim_chip)
+{
+    simulated_chip = sim_chip;
+}
+
+/**
+ * @brief Set the backend of pins that are initialised from now on with GPIO_BACKEND_DEFAULT.
+ *
+ * @param backend GPIO_BACKEND_CHARDEV, GPIO_BACKEND_GPIOMEM or GPIO_BACKEND_SIMULATED.
+ */
+void pi_zero_peripherals::gpio_set_default_backend(uint8_t backend)
+{
+    assert(backend == GPIO_BACKEND_CHARDEV || backend == GPIO_BACKEND_GPIOMEM || backend == GPIO_BACKEND_SIMULATED);
+
+    default_backend = backend;
+}
+
+/**
+ * @brief Get the backend of pins that are initialised with GPIO_BACKEND_DEFAULT.
+ *
+ * @return uint8_t GPIO_BACKEND_CHARDEV, GPIO_BACKEND_GPIOMEM or GPIO_BACKEND_SIMULATED.
+ */
+uint8_t pi_zero_peripherals::gpio_get_default_backend()
+{
+    return default_backend;
+}
+
+/**
+ * @brief Construct a new gpio_pin_t object. Does not access the chip.
  *
  * @param pin_number Number of the GPIO pin.
  */
 gpio_pin_t::gpio_pin_t(uint8_t pin_number) :
     pin_number(pin_number),
     initialised(0u),
-    gpio_line(gpiochip0.get_line(pin_number)),
+    gpio_line(),
     flags(0u),
-    event(0u)
+    event(0u),
+    backend(GPIO_BACKEND_CHARDEV),
+    registers(nullptr),
+    sim_chip(nullptr),
+    output_value(GPIO_STATE_LOW),
+    output_known(false)
 {}
 
 /**
@@ -95,10 +214,14 @@ gpio_pin_t::gpio_pin_t(uint8_t pin_number) :
  */
 gpio_pin_t::~gpio_pin_t()
 {
-    if (this->gpio_line.is_used())
+    if (this->initialised == 1u && this->backend == GPIO_BACKEND_CHARDEV && this->gpio_line.is_used())
     {
         this->gpio_line.release();
     }
+    else if (this->initialised == 1u && this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->release(this->pin_number);
+    }
 }
 
 /**
@@ -126,20 +249,74 @@ void gpio_pin_t::initialise(const gpio_config_t& config, std::string consumer_st
     /* Pin must not be initialised yet. */
     assert(this->initialised == 0u);
     /* Pin number must fall within the GPIO range. */
-    assert(this->pin_number < NUM_GPIO_PINS);
+    assert(gpio_is_valid(this->pin_number));
+
+    /* Event must be valid. */
+    assert(config.event <= GPIO_EVENT_BOTH_EDGES);
+
+    this->backend = config.backend == GPIO_BACKEND_DEFAULT ? default_backend : config.backend;
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        /* The registers do not report edges. */
+        assert(config.event == GPIO_EVENT_NONE);
 
-    /* Request GPIO pin for this program. */
-    this->gpio_line.request({
-        consumer_string,
-        config.direction == GPIOD_LINE_DIRECTION_OUTPUT ? gpiod::line_request::DIRECTION_OUTPUT : gpiod::line_request::DIRECTION_OUTPUT,
-        config.bias
-    }, config.output_value);
+        this->registers = &gpio_registers();
+
+        /* Set initialised to 1. */
+        this->initialised = 1u;
+
+        /* Sets the value before the function, so an output never drives the old value. */
+        this->reconfigure(config);
+
+        return;
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip = &gpio_sim_chip();
+        this->sim_chip->request(this->pin_number, config);
+
+        /* Set initialised to 1. */
+        this->initialised = 1u;
+        this->event = config.event;
+        this->output_value = config.output_value;
+        this->output_known = config.event == GPIO_EVENT_NONE && config.direction == GPIOD_LINE_DIRECTION_OUTPUT;
+
+        return;
+    }
+
+    /* Look up the line. */
+    this->gpio_line = gpio_chip().get_line(this->pin_number);
+    this->flags = gpio_bias_flags(config.bias);
+
+    /* The bias is part of the request, so the line never has a state that was not asked for. */
+    if (config.event != GPIO_EVENT_NONE)
+    {
+        /* Request GPIO pin for this program as an input that reports edges. */
+        this->gpio_line.request({
+            consumer_string,
+            config.event == GPIO_EVENT_RISING_EDGE ? gpiod::line_request::EVENT_RISING_EDGE
+                : config.event == GPIO_EVENT_FALLING_EDGE ? gpiod::line_request::EVENT_FALLING_EDGE
+                : gpiod::line_request::EVENT_BOTH_EDGES,
+            this->flags
+        });
+    }
+    else
+    {
+        /* Request GPIO pin for this program. */
+        this->gpio_line.request({
+            consumer_string,
+            config.direction == GPIOD_LINE_DIRECTION_OUTPUT ? gpiod::line_request::DIRECTION_OUTPUT : gpiod::line_request::DIRECTION_INPUT,
+            this->flags
+        }, config.output_value);
+    }
 
     /* Set initialised to 1. */
     this->initialised = 1u;
-
-    /* Set flags. */
-    this->set_bias(config.bias);
+    this->event = config.event;
+    this->output_value = config.output_value;
+    this->output_known = config.event == GPIO_EVENT_NONE && config.direction == GPIOD_LINE_DIRECTION_OUTPUT;
 }
 
 /**
@@ -151,11 +328,27 @@ void gpio_pin_t::set_direction(uint8_t direction)
 {
     /* Pin must be initialised. */
     assert(this->initialised == 1u);
-    /* GPIO line must be used by this program. */
-    assert(this->gpio_line.is_used());
     /* Direction must be valid. */
     assert(direction == GPIOD_LINE_DIRECTION_INPUT || direction == GPIOD_LINE_DIRECTION_OUTPUT);
 
+    /* An output that was an input drives whatever is in the output latch. */
+    this->output_known = false;
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        this->registers->set_function(this->pin_number, direction == GPIOD_LINE_DIRECTION_INPUT ? GPIO_FUNCTION_INPUT : GPIO_FUNCTION_OUTPUT);
+        return;
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->set_direction(this->pin_number, direction);
+        return;
+    }
+
+    /* GPIO line must be used by this program. */
+    assert(this->gpio_line.is_used());
+
     /* Set the GPIO direction. */
     direction == GPIOD_LINE_DIRECTION_INPUT ? this->gpio_line.set_direction_input() : this->gpio_line.set_direction_output();
 }
@@ -172,42 +365,139 @@ void gpio_pin_t::set_bias(uint8_t bias)
     /* Bias must be valid. */
     assert(bias >= GPIOD_LINE_BIAS_AS_IS && bias <= GPIOD_LINE_BIAS_PULL_DOWN);
 
-    /* Set new flags according to the bias. */
-    switch (bias)
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
     {
-    case GPIOD_LINE_BIAS_DISABLE:
-        this->flags |= gpiod::line_request::FLAG_BIAS_DISABLE;
-        break;
-    case GPIOD_LINE_BIAS_PULL_UP:
-        this->flags |= gpiod::line_request::FLAG_BIAS_PULL_UP;
-        break;
-    case GPIOD_LINE_BIAS_PULL_DOWN:
-        this->flags |= gpiod::line_request::FLAG_BIAS_PULL_DOWN;
-        break;
-    default:
-        break;
+        this->registers->set_pull(this->pin_number, bias);
+        return;
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->set_bias(this->pin_number, bias);
+        return;
+    }
+
+    if (bias == GPIOD_LINE_BIAS_AS_IS)
+    {
+        return;
     }
 
+    /* Replace the bias flags, only one bias can be active. */
+    this->flags = (this->flags & ~BIAS_FLAGS) | gpio_bias_flags(bias);
+
     /* Set new flags. */
     this->gpio_line.set_flags(this->flags);
 }
 
+/**
+ * @brief Change the direction, bias and output value of the pin at once, e.g. from an input with pull-up to
+ * an output that drives low. Pin must be initialised without an event and line must be used by this program.
+ * With the character device this is a single request, so the pin never has a mix of the old and new states.
+ * With the registers, an output gets its value before its function and an input gets its pull before its
+ * function, so the pin does not glitch either.
+ *
+ * @param config New configuration. The event and backend are ignored, a bias of GPIOD_LINE_BIAS_AS_IS keeps the bias.
+ */
+void gpio_pin_t::reconfigure(const gpio_config_t& config)
+{
+    /* Pin must be initialised. */
+    assert(this->initialised == 1u);
+    /* Lines that report edges can not be reconfigured. */
+    assert(this->event == GPIO_EVENT_NONE);
+    /* Direction must be valid. */
+    assert(config.direction == GPIOD_LINE_DIRECTION_INPUT || config.direction == GPIOD_LINE_DIRECTION_OUTPUT);
+
+    const bool output = config.direction == GPIOD_LINE_DIRECTION_OUTPUT;
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        if (output)
+        {
+            this->registers->write_pin(this->pin_number, config.output_value);
+            this->registers->set_function(this->pin_number, GPIO_FUNCTION_OUTPUT);
+            this->registers->set_pull(this->pin_number, config.bias);
+        }
+        else
+        {
+            this->registers->set_pull(this->pin_number, config.bias);
+            this->registers->set_function(this->pin_number, GPIO_FUNCTION_INPUT);
+        }
+    }
+    else if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->reconfigure(this->pin_number, config);
+    }
+    else
+    {
+        /* GPIO line must be used by this program. */
+        assert(this->gpio_line.is_used());
+
+        if (config.bias != GPIOD_LINE_BIAS_AS_IS)
+        {
+            this->flags = (this->flags & ~BIAS_FLAGS) | gpio_bias_flags(config.bias);
+        }
+
+        this->gpio_line.set_config(
+            output ? gpiod::line_request::DIRECTION_OUTPUT : gpiod::line_request::DIRECTION_INPUT,
+            this->flags,
+            config.output_value
+        );
+    }
+
+    this->output_value = config.output_value;
+    this->output_known = output;
+}
+
 /**
  * @brief Set value of the pin. Pin must be initialised and line must be used by this program.
+ * Returns immediately if the pin already drives the value.
  *
  * @param value Value to set. Must be GPIO_STATE_HIGH (1) or GPIO_STATE_LOW (0).
  */
 void gpio_pin_t::set_value(uint8_t value)
+{
+    if (this->output_known && this->output_value == value)
+    {
+        this->write_counters.suppressed++;
+        return;
+    }
+
+    this->force_value(value);
+}
+
+/**
+ * @brief Set value of the pin, also if the pin already drives it, e.g. when something else may have
+ * changed the pin. Pin must be initialised and line must be used by this program.
+ *
+ * @param value Value to set. Must be GPIO_STATE_HIGH (1) or GPIO_STATE_LOW (0).
+ */
+void gpio_pin_t::force_value(uint8_t value)
 {
     /* Pin must be initialised. */
     assert(this->initialised == 1u);
-    /* GPIO line must be used by this program. */
-    assert(this->gpio_line.is_used());
     /* Value must be high or low. */
     assert(value == GPIO_STATE_HIGH || value == GPIO_STATE_LOW);
 
-    /* Set new value. */
-    this->gpio_line.set_value(value);
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        this->registers->write_pin(this->pin_number, value);
+    }
+    else if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->write(this->pin_number, value);
+    }
+    else
+    {
+        /* GPIO line must be used by this program. */
+        assert(this->gpio_line.is_used());
+
+        /* Set new value. */
+        this->gpio_line.set_value(value);
+    }
+
+    this->output_value = value;
+    this->output_known = true;
+    this->write_counters.writes++;
 }
 
 /**
@@ -219,6 +509,20 @@ uint8_t gpio_pin_t::get_value()
 {
     /* Pin must be initialised. */
     assert(this->initialised == 1u);
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        /* Function must be input. */
+        assert(this->registers->get_function(this->pin_number) == GPIO_FUNCTION_INPUT);
+
+        return this->registers->get_level(this->pin_number);
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        return this->sim_chip->read(this->pin_number);
+    }
+
     /* GPIO line must be used by this program. */
     assert(this->gpio_line.is_used());
     /* Function must be input. */
@@ -227,3 +531,127 @@ uint8_t gpio_pin_t::get_value()
     /* Return value. */
     return this->gpio_line.get_value();
 }
+
+/**
+ * @brief Get the number of writes to the pin and the number of writes that were suppressed.
+ *
+ * @return gpio_write_counters_t Counters.
+ */
+gpio_write_counters_t gpio_pin_t::get_write_counters()
+{
+    return this->write_counters;
+}
+
+/**
+ * @brief Convert an event of libgpiod to a gpio_event_t.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param line_event Event to convert.
+ * @return gpio_event_t Converted event.
+ */
+static gpio_event_t convert_event(uint8_t pin_number, const gpiod::line_event& line_event)
+{
+    return {
+        pin_number,
+        line_event.event_type == gpiod::line_event::RISING_EDGE ? GPIO_EVENT_RISING_EDGE : GPIO_EVENT_FALLING_EDGE,
+        line_event.timestamp
+    };
+}
+
+/**
+ * @brief Wait for an edge event. Pin must be initialised with an event.
+ * Sleeps in the kernel, so waiting does not use CPU time.
+ *
+ * @param timeout Maximum time to wait.
+ * @return true if an event is waiting to be read, false on timeout.
+ */
+bool gpio_pin_t::wait_event(std::chrono::nanoseconds timeout)
+{
+    /* Pin must be initialised with an event. */
+    assert(this->initialised == 1u && this->event != GPIO_EVENT_NONE);
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        return this->sim_chip->wait_event(this->pin_number, timeout);
+    }
+
+    return this->gpio_line.event_wait(timeout);
+}
+
+/**
+ * @brief Read one edge event. Blocks until there is one. Pin must be initialised with an event.
+ *
+ * @return gpio_event_t The event.
+ */
+gpio_event_t gpio_pin_t::read_event()
+{
+    /* Pin must be initialised with an event. */
+    assert(this->initialised == 1u && this->event != GPIO_EVENT_NONE);
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        std::vector<gpio_event_t> events;
+
+        this->sim_chip->read_events(this->pin_number, events, 1u);
+
+        return events.front();
+    }
+
+    return convert_event(this->pin_number, this->gpio_line.event_read());
+}
+
+/**
+ * @brief Read all queued edge events, up to the 16 the kernel returns per read, with one system call.
+ * Blocks until there is at least one. Pin must be initialised with an event.
+ *
+ * @param events Vector to append the events to.
+ * @return uint8_t Number of events read.
+ */
+uint8_t gpio_pin_t::read_events(std::vector<gpio_event_t>& events)
+{
+    /* Pin must be initialised with an event. */
+    assert(this->initialised == 1u && this->event != GPIO_EVENT_NONE);
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        return this->sim_chip->read_events(this->pin_number, events);
+    }
+
+    const std::vector<gpiod::line_event> line_events = this->gpio_line.event_read_multiple();
+
+    for (const gpiod::line_event& line_event : line_events)
+    {
+        events.push_back(convert_event(this->pin_number, line_event));
+    }
+
+    return line_events.size();
+}
+
+/**
+ * @brief Get the file descriptor on which edge events arrive, e.g. to wait for them with poll or epoll.
+ * Pin must be initialised with an event.
+ *
+ * @return int File descriptor, readable when an event is waiting.
+ */
+int gpio_pin_t::get_event_fd()
+{
+    /* Pin must be initialised with an event. */
+    assert(this->initialised == 1u && this->event != GPIO_EVENT_NONE);
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        return this->sim_chip->get_event_fd(this->pin_number);
+    }
+
+    return this->gpio_line.event_get_fd();
+}
+
+/**
+ * @brief Get the number of the GPIO pin.
+ *
+ * @return uint8_t Number of the GPIO pin.
+ */
+uint8_t gpio_pin_t::get_pin_number()
+{
+    return this->pin_number;
+}
@@ -0,0 +1,386 @@
+/**
+ * @file gpio_port.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the implementation for the gpio_port class.
+ *        All pins of a port are one line_bulk, so they are requested once and every read or write of the port is
+ *        a single ioctl, which also makes the pins change at the same instant.
+ * @date 18-10-2026
+ */
+
+#include <algorithm>
+#include <assert.h>
+
+#include "include/gpio_port.hpp"
+#include "include/gpio_sim_chip.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* Define default config. */
+static constexpr gpio_config_t DEFAULT_CONFIG;
+
+/**
+ * @brief Construct a new gpio_port_t object.
+ *
+ * @param pin_numbers Numbers of the GPIO pins, in bit order.
+ */
+gpio_port_t::gpio_port_t(std::initializer_list<uint8_t> pin_numbers) :
+    gpio_port_t(std::vector<uint8_t>(pin_numbers))
+{}
+
+/**
+ * @brief Construct a new gpio_port_t object.
+ *
+ * @param pin_numbers Numbers of the GPIO pins, in bit order.
+ */
+gpio_port_t::gpio_port_t(const std::vector<uint8_t>& pin_numbers) :
+    pin_numbers(pin_numbers),
+    initialised(0u),
+    output_values(0u),
+    output_known(false),
+    buffer(pin_numbers.size(), 0),
+    backend(GPIO_BACKEND_CHARDEV),
+    registers(nullptr),
+    sim_chip(nullptr),
+    flags(0u)
+{
+    /* Number of pins must fit in the bitmask. */
+    assert(pin_numbers.size() > 0u && pin_numbers.size() <= MAX_PINS);
+
+    for (const uint8_t pin_number : pin_numbers)
+    {
+        /* Pin number must fall within the GPIO range. */
+        assert(gpio_is_valid(pin_number));
+    }
+}
+
+/**
+ * @brief Destroy a gpio_port_t object.
+ * Release the GPIO lines if they are used by this program.
+ */
+gpio_port_t::~gpio_port_t()
+{
+    if (this->initialised == 1u && this->backend == GPIO_BACKEND_CHARDEV)
+    {
+        this->gpio_lines.release();
+    }
+    else if (this->initialised == 1u && this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        for (const uint8_t pin_number : this->pin_numbers)
+        {
+            this->sim_chip->release(pin_number);
+        }
+    }
+}
+
+/**
+ * @brief Initialise the port. Can only be called once.
+ * Requests all GPIO pins of the port for this program as inputs.
+ *
+ * @param consumer_string Name of the consumer (default: "default").
+ */
+void gpio_port_t::initialise(std::string consumer_string)
+{
+    initialise(DEFAULT_CONFIG, consumer_string);
+}
+
+/**
+ * @brief Initialise the port. Can only be called once.
+ * Requests all GPIO pins of the port for this program in a single request, with the same configuration.
+ *
+ * @param config Configuration for the GPIO pins. The output value is applied to every pin.
+ * @param consumer_string Name of the consumer (default: "default").
+ */
+void gpio_port_t::initialise(const gpio_config_t& config, std::string consumer_string)
+{
+    /* Port must not be initialised yet. */
+    assert(this->initialised == 0u);
+
+    this->output_values = config.output_value == GPIO_STATE_HIGH ? (uint32_t)((1ull << this->pin_numbers.size()) - 1u) : 0u;
+    this->output_known = config.direction == GPIOD_LINE_DIRECTION_OUTPUT;
+    this->backend = config.backend == GPIO_BACKEND_DEFAULT ? gpio_get_default_backend() : config.backend;
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        this->registers = &gpio_registers();
+
+        /* Set initialised to 1. */
+        this->initialised = 1u;
+
+        this->reconfigure(config);
+
+        return;
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        gpio_config_t line_config = config;
+
+        /* Ports do not report edges. */
+        line_config.event = GPIO_EVENT_NONE;
+        this->sim_chip = &gpio_sim_chip();
+
+        for (size_t i = 0; i < this->pin_numbers.size(); i++)
+        {
+            try
+            {
+                this->sim_chip->request(this->pin_numbers[i], line_config);
+            }
+            catch (...)
+            {
+                /* A bulk request gets all lines or none. */
+                for (size_t j = 0; j < i; j++)
+                {
+                    this->sim_chip->release(this->pin_numbers[j]);
+                }
+
+                throw;
+            }
+        }
+
+        /* Set initialised to 1. */
+        this->initialised = 1u;
+
+        return;
+    }
+
+    /* Look up the lines. */
+    for (const uint8_t pin_number : this->pin_numbers)
+    {
+        this->gpio_lines.append(gpio_chip().get_line(pin_number));
+    }
+
+    this->flags = gpio_bias_flags(config.bias);
+
+    std::fill(this->buffer.begin(), this->buffer.end(), config.output_value);
+
+    /* Request all GPIO pins for this program. */
+    this->gpio_lines.request({
+        consumer_string,
+        config.direction == GPIOD_LINE_DIRECTION_OUTPUT ? gpiod::line_request::DIRECTION_OUTPUT : gpiod::line_request::DIRECTION_INPUT,
+        this->flags
+    }, this->buffer);
+
+    /* Set initialised to 1. */
+    this->initialised = 1u;
+}
+
+/**
+ * @brief Change the direction, bias and output value of all pins of the port at once, e.g. to release an
+ * open-drain bus by switching from output low to input. Port must be initialised.
+ * With the character device this is a single request for all pins. With the registers, outputs get their values
+ * before their functions and inputs get their pulls before their functions, so no pin glitches.
+ *
+ * @param config New configuration. The output value is applied to every pin. The event and backend are ignored,
+ * a bias of GPIOD_LINE_BIAS_AS_IS keeps the bias.
+ */
+void gpio_port_t::reconfigure(const gpio_config_t& config)
+{
+    /* Port must be initialised. */
+    assert(this->initialised == 1u);
+    /* Direction must be valid. */
+    assert(config.direction == GPIOD_LINE_DIRECTION_INPUT || config.direction == GPIOD_LINE_DIRECTION_OUTPUT);
+
+    const bool output = config.direction == GPIOD_LINE_DIRECTION_OUTPUT;
+    const uint32_t values = config.output_value == GPIO_STATE_HIGH ? (uint32_t)((1ull << this->pin_numbers.size()) - 1u) : 0u;
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        const uint64_t pins = this->to_gpio_mask(~0u);
+
+        if (output)
+        {
+            this->registers->set_pins(this->to_gpio_mask(values));
+            this->registers->clear_pins(this->to_gpio_mask(~values));
+            this->registers->set_functions(pins, GPIO_FUNCTION_OUTPUT);
+            this->registers->set_pulls(pins, config.bias);
+        }
+        else
+        {
+            this->registers->set_pulls(pins, config.bias);
+            this->registers->set_functions(pins, GPIO_FUNCTION_INPUT);
+        }
+    }
+    else if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        for (const uint8_t pin_number : this->pin_numbers)
+        {
+            this->sim_chip->reconfigure(pin_number, config);
+        }
+    }
+    else
+    {
+        if (config.bias != GPIOD_LINE_BIAS_AS_IS)
+        {
+            this->flags = gpio_bias_flags(config.bias);
+        }
+
+        std::fill(this->buffer.begin(), this->buffer.end(), config.output_value);
+
+        this->gpio_lines.set_config(
+            output ? gpiod::line_request::DIRECTION_OUTPUT : gpiod::line_request::DIRECTION_INPUT,
+            this->flags,
+            this->buffer
+        );
+    }
+
+    this->output_values = values;
+    this->output_known = output;
+}
+
+/**
+ * @brief Set the values of all pins of the port. Port must be initialised as output.
+ * Returns immediately if the pins already drive the values.
+ *
+ * @param values Bitmask of values, bit i is the value of the i-th pin.
+ */
+void gpio_port_t::set_values(uint32_t values)
+{
+    /* Bits above the pins of the port do not matter. */
+    values &= (uint32_t)((1ull << this->pin_numbers.size()) - 1u);
+
+    if (this->output_known && this->output_values == values)
+    {
+        this->write_counters.suppressed++;
+        return;
+    }
+
+    this->force_values(values);
+}
+
+/**
+ * @brief Set the values of all pins of the port, also if the pins already drive them.
+ * Port must be initialised as output.
+ *
+ * @param values Bitmask of values, bit i is the value of the i-th pin.
+ */
+void gpio_port_t::force_values(uint32_t values)
+{
+    /* Port must be initialised. */
+    assert(this->initialised == 1u);
+
+    values &= (uint32_t)((1ull << this->pin_numbers.size()) - 1u);
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        /* One store for the pins that go high, one for the pins that go low. */
+        this->registers->set_pins(this->to_gpio_mask(values));
+        this->registers->clear_pins(this->to_gpio_mask(~values));
+    }
+    else if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        this->sim_chip->write_pins(this->to_gpio_mask(~0u), this->to_gpio_mask(values));
+    }
+    else
+    {
+        for (size_t i = 0; i < this->pin_numbers.size(); i++)
+        {
+            this->buffer[i] = (values >> i) & 1u;
+        }
+
+        /* Set new values. */
+        this->gpio_lines.set_values(this->buffer);
+    }
+
+    this->output_values = values;
+    this->output_known = true;
+    this->write_counters.writes++;
+}
+
+/**
+ * @brief Set the values of some pins of the port, the others keep the value they were last set to.
+ * Port must be initialised as output.
+ *
+ * @param values Bitmask of values, bit i is the value of the i-th pin.
+ * @param mask Bitmask of the pins to change.
+ */
+void gpio_port_t::set_values(uint32_t values, uint32_t mask)
+{
+    this->set_values((this->output_values & ~mask) | (values & mask));
+}
+
+/**
+ * @brief Get the values of all pins of the port. Port must be initialised.
+ *
+ * @return uint32_t Bitmask of values, bit i is the value of the i-th pin.
+ */
+uint32_t gpio_port_t::get_values()
+{
+    /* Port must be initialised. */
+    assert(this->initialised == 1u);
+
+    if (this->backend == GPIO_BACKEND_GPIOMEM)
+    {
+        const uint64_t levels = this->registers->get_levels();
+        uint32_t result = 0u;
+
+        for (size_t i = 0; i < this->pin_numbers.size(); i++)
+        {
+            result |= (uint32_t)((levels >> this->pin_numbers[i]) & 1u) << i;
+        }
+
+        return result;
+    }
+
+    if (this->backend == GPIO_BACKEND_SIMULATED)
+    {
+        uint32_t result = 0u;
+
+        for (size_t i = 0; i < this->pin_numbers.size(); i++)
+        {
+            result |= (uint32_t)this->sim_chip->read(this->pin_numbers[i]) << i;
+        }
+
+        return result;
+    }
+
+    const std::vector<int> values = this->gpio_lines.get_values();
+    uint32_t result = 0u;
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        result |= (uint32_t)(values[i] != 0) << i;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Get the number of pins of the port.
+ *
+ * @return uint8_t Number of pins.
+ */
+uint8_t gpio_port_t::get_size()
+{
+    return this->pin_numbers.size();
+}
+
+/**
+ * @brief Get the number of writes to the port and the number of writes that were suppressed.
+ *
+ * @return gpio_write_counters_t Counters.
+ */
+gpio_write_counters_t gpio_port_t::get_write_counters()
+{
+    return this->write_counters;
+}
+
+/**
+ * @brief Convert port values to a mask of GPIO pins, for the GPSETn and GPCLRn registers.
+ *
+ * @param values Bitmask of values, bit i is the value of the i-th pin.
+ * @return uint64_t Bit n set for GPIO pin n if the value of its pin is set.
+ */
+uint64_t gpio_port_t::to_gpio_mask(uint32_t values)
+{
+    uint64_t mask = 0u;
+
+    for (size_t i = 0; i < this->pin_numbers.size(); i++)
+    {
+        if ((values >> i) & 1u)
+        {
+            mask |= 1ull << this->pin_numbers[i];
+        }
+    }
+
+    return mask;
+}
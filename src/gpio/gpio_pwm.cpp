@@ -0,0 +1,259 @@
+/**
+ * @file gpio_pwm.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the implementation for the gpio_pwm class.
+ *        At the start of a period all channels with an on time are switched on with one write, then the thread
+ *        sleeps until the next distinct off time and switches off every channel that ends there with one write.
+ *        Sleeps are absolute (clock_nanosleep with TIMER_ABSTIME), so errors do not accumulate.
+ *        New duty cycles are only taken at a period boundary, and only if the thread can take the lock without
+ *        waiting, so a period is never cut short and the thread never blocks on the caller.
+ * @date 18-10-2026
+ */
+
+#include <algorithm>
+#include <assert.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "include/gpio_pwm.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Get the time of CLOCK_MONOTONIC.
+ *
+ * @return std::chrono::nanoseconds Time.
+ */
+static std::chrono::nanoseconds monotonic_now()
+{
+    timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+/**
+ * @brief Sleep until a time of CLOCK_MONOTONIC.
+ *
+ * @param time Time to wake up at.
+ */
+static void monotonic_sleep_until(std::chrono::nanoseconds time)
+{
+    const timespec until = { (time_t)(time.count() / 1000000000), (long)(time.count() % 1000000000) };
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, nullptr) != 0)
+    {
+        /* Interrupted by a signal. */
+    }
+}
+
+/**
+ * @brief Construct a new gpio_pwm_t object. All channels start with a duty cycle of 0.
+ *
+ * @param port Port of which every pin is a channel. Must be initialised as output.
+ * @param period PWM period.
+ */
+gpio_pwm_t::gpio_pwm_t(gpio_port_t& port, std::chrono::nanoseconds period) :
+    port(port),
+    period(period),
+    running(false),
+    pending_changed(true),
+    timeline_size(0u)
+{
+    assert(period.count() > 0);
+
+    this->pending_on_times.fill(std::chrono::nanoseconds(0));
+    this->on_times.fill(std::chrono::nanoseconds(0));
+}
+
+/**
+ * @brief Destroy a gpio_pwm_t object. Stops the thread.
+ */
+gpio_pwm_t::~gpio_pwm_t()
+{
+    this->stop();
+}
+
+/**
+ * @brief Set the duty cycle of a channel. Takes effect at the start of the next period.
+ *
+ * @param channel Channel, the index of the pin in the port.
+ * @param duty_cycle Duty cycle between 0 and 1.
+ */
+void gpio_pwm_t::set_duty_cycle(uint8_t channel, double duty_cycle)
+{
+    assert(channel < this->port.get_size());
+    assert(duty_cycle >= 0.0 && duty_cycle <= 1.0);
+
+    std::lock_guard<std::mutex> lock(this->pending_mutex);
+
+    this->pending_on_times[channel] = std::chrono::nanoseconds((int64_t)(duty_cycle * this->period.count()));
+    this->pending_changed = true;
+}
+
+/**
+ * @brief Start the PWM thread.
+ *
+ * @param priority SCHED_FIFO priority of the thread. Without permission for it, the thread runs with a normal priority.
+ */
+void gpio_pwm_t::start(int priority)
+{
+    /* PWM must not be running yet. */
+    assert(!this->running);
+
+    this->running = true;
+    this->thread = std::thread(&gpio_pwm_t::run, this, priority);
+}
+
+/**
+ * @brief Stop the PWM thread at the end of the current period. All pins are left low.
+ */
+void gpio_pwm_t::stop()
+{
+    this->running = false;
+
+    if (this->thread.joinable())
+    {
+        this->thread.join();
+    }
+}
+
+/**
+ * @brief Get the timing of the PWM thread so far.
+ *
+ * @return gpio_pwm_statistics_t Statistics.
+ */
+gpio_pwm_statistics_t gpio_pwm_t::get_statistics()
+{
+    std::lock_guard<std::mutex> lock(this->statistics_mutex);
+
+    return this->statistics;
+}
+
+/**
+ * @brief Merge the edges of all channels into the sorted timeline of one period.
+ */
+void gpio_pwm_t::build_timeline()
+{
+    const uint8_t channels = this->port.get_size();
+    std::array<uint8_t, gpio_port_t::MAX_PINS> order;
+    uint32_t values = 0u;
+
+    for (size_t channel = 0; channel < channels; channel++)
+    {
+        order[channel] = channel;
+
+        if (this->on_times[channel].count() > 0)
+        {
+            values |= 1u << channel;
+        }
+    }
+
+    std::sort(order.begin(), order.begin() + channels, [this](uint8_t a, uint8_t b) { return this->on_times[a] < this->on_times[b]; });
+
+    this->timeline[0] = { std::chrono::nanoseconds(0), values };
+    this->timeline_size = 1u;
+
+    for (size_t i = 0; i < channels; i++)
+    {
+        const std::chrono::nanoseconds off_time = this->on_times[order[i]];
+
+        /* Always off or always on. */
+        if (off_time.count() == 0 || off_time >= this->period)
+        {
+            continue;
+        }
+
+        values &= ~(1u << order[i]);
+
+        /* Channels that switch off at the same time share a write. */
+        if (this->timeline[this->timeline_size - 1u].offset == off_time)
+        {
+            this->timeline[this->timeline_size - 1u].values = values;
+        }
+        else
+        {
+            this->timeline[this->timeline_size++] = { off_time, values };
+        }
+    }
+}
+
+/**
+ * @brief Body of the PWM thread.
+ *
+ * @param priority SCHED_FIFO priority to request.
+ */
+void gpio_pwm_t::run(int priority)
+{
+    gpio_pwm_statistics_t statistics;
+    std::chrono::nanoseconds jitter_sum(0);
+    sched_param parameters = {};
+    uint32_t last_values = 0u;
+
+    parameters.sched_priority = priority;
+    statistics.realtime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+
+    this->port.set_values(0u);
+
+    std::chrono::nanoseconds period_start = monotonic_now();
+
+    while (this->running)
+    {
+        if (this->pending_mutex.try_lock())
+        {
+            if (this->pending_changed)
+            {
+                this->on_times = this->pending_on_times;
+                this->pending_changed = false;
+                this->build_timeline();
+            }
+
+            this->pending_mutex.unlock();
+        }
+
+        for (size_t i = 0; i < this->timeline_size; i++)
+        {
+            const edge_t& edge = this->timeline[i];
+
+            /* Nothing changes, e.g. at the start of a period in which all channels are always on. */
+            if (edge.values == last_values)
+            {
+                continue;
+            }
+
+            monotonic_sleep_until(period_start + edge.offset);
+
+            const std::chrono::nanoseconds jitter = monotonic_now() - (period_start + edge.offset);
+
+            this->port.set_values(edge.values);
+            last_values = edge.values;
+
+            statistics.writes++;
+            statistics.max_jitter = std::max(statistics.max_jitter, jitter);
+            jitter_sum += jitter;
+        }
+
+        /* Wait for the end of the period, also if the timeline had nothing to write. */
+        period_start += this->period;
+        monotonic_sleep_until(period_start);
+        statistics.periods++;
+
+        /* Start again from now if the thread fell more than a period behind, instead of catching up. */
+        const std::chrono::nanoseconds now = monotonic_now();
+
+        if (now - period_start > this->period)
+        {
+            period_start = now;
+        }
+
+        if (this->statistics_mutex.try_lock())
+        {
+            statistics.mean_jitter = statistics.writes > 0u ? jitter_sum / (int64_t)statistics.writes : std::chrono::nanoseconds(0);
+            this->statistics = statistics;
+            this->statistics_mutex.unlock();
+        }
+    }
+
+    this->port.set_values(0u);
+}
@@ -0,0 +1,250 @@
+/**
+ * @file gpio_registers.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the implementation for the gpio_registers class.
+ *        /dev/gpiomem maps only the GPIO register block and does not need root. A store to a register takes tens
+ *        of nanoseconds, where a write through the GPIO character device is an ioctl of several microseconds.
+ *        With a file instead of /dev/gpiomem the registers are plain memory: GPSETn and GPCLRn keep the last mask
+ *        that was written and GPLEVn is whatever the test puts there.
+ * @date 18-10-2026
+ */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+#include "include/gpio_exception.hpp"
+#include "include/gpio_pin.hpp"
+#include "include/gpio_registers.hpp"
+
+using namespace pi_zero_peripherals;
+
+/* GPPUD values. */
+static constexpr uint32_t PULL_OFF  = 0b00u;
+static constexpr uint32_t PULL_DOWN = 0b01u;
+static constexpr uint32_t PULL_UP   = 0b10u;
+
+/**
+ * @brief Construct a new gpio_registers_t object and map the registers.
+ *
+ * @param file_name File to map, /dev/gpiomem or a file that stands in for the registers.
+ */
+gpio_registers_t::gpio_registers_t(const std::string& file_name)
+{
+    const int fd = open(file_name.c_str(), O_RDWR | O_SYNC | O_CLOEXEC);
+
+    if (fd == -1)
+    {
+        throw gpio_register_exception("Could not open " + file_name);
+    }
+
+    void* memory = mmap(nullptr, REGISTERS_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    /* The mapping stays valid without the file descriptor. */
+    close(fd);
+
+    if (memory == MAP_FAILED)
+    {
+        throw gpio_register_exception("Could not map " + file_name);
+    }
+
+    this->registers = static_cast<volatile uint32_t*>(memory);
+}
+
+/**
+ * @brief Destroy a gpio_registers_t object and unmap the registers.
+ */
+gpio_registers_t::~gpio_registers_t()
+{
+    munmap(const_cast<uint32_t*>(this->registers), REGISTERS_SIZE);
+}
+
+/**
+ * @brief Set the function of a pin.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param function GPIO_FUNCTION_INPUT or GPIO_FUNCTION_OUTPUT.
+ */
+void gpio_registers_t::set_function(uint8_t pin_number, uint8_t function)
+{
+    assert(gpio_is_valid(pin_number));
+    assert(function <= 0b111u);
+
+    volatile uint32_t& gpfsel = this->registers[GPFSEL0 + pin_number / 10u];
+    const uint8_t shift = (pin_number % 10u) * 3u;
+
+    gpfsel = (gpfsel & ~(0b111u << shift)) | ((uint32_t)function << shift);
+}
+
+/**
+ * @brief Set the function of many pins, with one read-modify-write per GPFSELn register.
+ *
+ * @param mask Bit n set for GPIO pin n.
+ * @param function GPIO_FUNCTION_INPUT or GPIO_FUNCTION_OUTPUT.
+ */
+void gpio_registers_t::set_functions(uint64_t mask, uint8_t function)
+{
+    assert(function <= 0b111u);
+    assert(mask < (1ull << GPIO_PIN_COUNT));
+
+    /* Each GPFSELn register holds the functions of 10 pins. */
+    for (uint8_t first = 0u; first < GPIO_PIN_COUNT; first += 10u)
+    {
+        uint32_t clear = 0u;
+        uint32_t set = 0u;
+
+        for (uint8_t pin_number = first; pin_number < first + 10u && pin_number < GPIO_PIN_COUNT; pin_number++)
+        {
+            if ((mask >> pin_number) & 1u)
+            {
+                const uint8_t shift = (pin_number - first) * 3u;
+
+                clear |= 0b111u << shift;
+                set |= (uint32_t)function << shift;
+            }
+        }
+
+        if (clear != 0u)
+        {
+            volatile uint32_t& gpfsel = this->registers[GPFSEL0 + first / 10u];
+
+            gpfsel = (gpfsel & ~clear) | set;
+        }
+    }
+}
+
+/**
+ * @brief Get the function of a pin.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return uint8_t Function, e.g. GPIO_FUNCTION_INPUT or GPIO_FUNCTION_OUTPUT.
+ */
+uint8_t gpio_registers_t::get_function(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    return (this->registers[GPFSEL0 + pin_number / 10u] >> ((pin_number % 10u) * 3u)) & 0b111u;
+}
+
+/**
+ * @brief Set the pull-up or pull-down of a pin with the GPPUD/GPPUDCLKn sequence of the BCM2835.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param bias GPIOD_LINE_BIAS_DISABLE, GPIOD_LINE_BIAS_PULL_UP or GPIOD_LINE_BIAS_PULL_DOWN. GPIOD_LINE_BIAS_AS_IS does nothing.
+ */
+void gpio_registers_t::set_pull(uint8_t pin_number, uint8_t bias)
+{
+    assert(gpio_is_valid(pin_number));
+
+    this->set_pulls(1ull << pin_number, bias);
+}
+
+/**
+ * @brief Set the pull-up or pull-down of many pins with a single GPPUD/GPPUDCLKn sequence.
+ *
+ * @param mask Bit n set for GPIO pin n.
+ * @param bias GPIOD_LINE_BIAS_DISABLE, GPIOD_LINE_BIAS_PULL_UP or GPIOD_LINE_BIAS_PULL_DOWN. GPIOD_LINE_BIAS_AS_IS does nothing.
+ */
+void gpio_registers_t::set_pulls(uint64_t mask, uint8_t bias)
+{
+    assert(mask < (1ull << GPIO_PIN_COUNT));
+
+    if (bias == GPIOD_LINE_BIAS_AS_IS || mask == 0u)
+    {
+        return;
+    }
+
+    /* The control signal must be set up for 150 cycles before and after the clock. */
+    this->registers[GPPUD] = bias == GPIOD_LINE_BIAS_PULL_UP ? PULL_UP : bias == GPIOD_LINE_BIAS_PULL_DOWN ? PULL_DOWN : PULL_OFF;
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+    this->registers[GPPUDCLK0] = (uint32_t)mask;
+    this->registers[GPPUDCLK0 + 1u] = (uint32_t)(mask >> 32u);
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+    this->registers[GPPUD] = PULL_OFF;
+    this->registers[GPPUDCLK0] = 0u;
+    this->registers[GPPUDCLK0 + 1u] = 0u;
+}
+
+/**
+ * @brief Drive pins high.
+ *
+ * @param mask Bit n set for GPIO pin n.
+ */
+void gpio_registers_t::set_pins(uint64_t mask)
+{
+    if ((uint32_t)mask != 0u)
+    {
+        this->registers[GPSET0] = (uint32_t)mask;
+    }
+
+    if ((uint32_t)(mask >> 32u) != 0u)
+    {
+        this->registers[GPSET0 + 1u] = (uint32_t)(mask >> 32u);
+    }
+}
+
+/**
+ * @brief Drive pins low.
+ *
+ * @param mask Bit n set for GPIO pin n.
+ */
+void gpio_registers_t::clear_pins(uint64_t mask)
+{
+    if ((uint32_t)mask != 0u)
+    {
+        this->registers[GPCLR0] = (uint32_t)mask;
+    }
+
+    if ((uint32_t)(mask >> 32u) != 0u)
+    {
+        this->registers[GPCLR0 + 1u] = (uint32_t)(mask >> 32u);
+    }
+}
+
+/**
+ * @brief Drive one pin.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+void gpio_registers_t::write_pin(uint8_t pin_number, uint8_t value)
+{
+    assert(gpio_is_valid(pin_number));
+
+    this->registers[(value == GPIO_STATE_HIGH ? GPSET0 : GPCLR0) + pin_number / 32u] = 1u << (pin_number % 32u);
+}
+
+/**
+ * @brief Get the levels of all pins.
+ *
+ * @return uint64_t Bit n is the level of GPIO pin n.
+ */
+uint64_t gpio_registers_t::get_levels()
+{
+    return this->registers[GPLEV0] | ((uint64_t)this->registers[GPLEV0 + 1u] << 32u);
+}
+
+/**
+ * @brief Get the level of one pin.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return uint8_t GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+uint8_t gpio_registers_t::get_level(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    return (this->registers[GPLEV0 + pin_number / 32u] >> (pin_number % 32u)) & 1u;
+}
+
+/**
+ * @brief Get the mapped registers, e.g. for a test to inspect them.
+ *
+ * @return volatile uint32_t* The registers.
+ */
+volatile uint32_t* gpio_registers_t::get_registers()
+{
+    return this->registers;
+}
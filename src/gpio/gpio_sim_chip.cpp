@@ -0,0 +1,543 @@
+/**
+ * @file gpio_sim_chip.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the gpio_sim_chip_t class, a simulated GPIO chip for testing without hardware.
+ *        Every line that reports edges has an eventfd that is readable while events are queued, so poll, epoll
+ *        and gpio_event_loop_t work on simulated pins the same way as on the character device.
+ *        An input without a level from the test follows its pull-up or pull-down, and is low without a bias.
+ * @date 18-10-2026
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <time.h>
+#include <unistd.h>
+
+#include "include/gpio_exception.hpp"
+#include "include/gpio_sim_chip.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new gpio_sim_chip_t object. No line is requested.
+ */
+gpio_sim_chip_t::gpio_sim_chip_t() :
+    writes(0u)
+{}
+
+/**
+ * @brief Destroy a gpio_sim_chip_t object. Closes the event file descriptors.
+ */
+gpio_sim_chip_t::~gpio_sim_chip_t()
+{
+    for (line_t& line : this->lines)
+    {
+        if (line.event_fd != -1)
+        {
+            close(line.event_fd);
+        }
+    }
+}
+
+/**
+ * @brief Request a line, like a line request to the kernel.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param config Configuration of the line.
+ */
+void gpio_sim_chip_t::request(uint8_t pin_number, const gpio_config_t& config)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    line_t& line = this->lines[pin_number];
+
+    /* The kernel refuses a line that is already requested. */
+    if (line.requested)
+    {
+        throw std::system_error(EBUSY, std::system_category(), "GPIO" + std::to_string(pin_number) + " is already requested");
+    }
+
+    if (config.event != GPIO_EVENT_NONE && line.event_fd == -1)
+    {
+        line.event_fd = eventfd(0u, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        if (line.event_fd == -1)
+        {
+            throw gpio_event_exception("Could not create event file descriptor for GPIO" + std::to_string(pin_number));
+        }
+    }
+
+    const uint8_t old_level = this->level(line);
+
+    line.requested = true;
+    line.direction = config.event != GPIO_EVENT_NONE ? (uint8_t)GPIOD_LINE_DIRECTION_INPUT : config.direction;
+    line.bias = config.bias;
+    line.event = config.event;
+    line.output = config.output_value;
+    line.events.clear();
+
+    if (this->level(line) != old_level && line.direction == GPIOD_LINE_DIRECTION_OUTPUT)
+    {
+        this->transitions.push_back({ pin_number, line.output, now() });
+    }
+}
+
+/**
+ * @brief Release a line. Its queued events are dropped.
+ *
+ * @param pin_number Number of the GPIO pin.
+ */
+void gpio_sim_chip_t::release(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    line_t& line = this->lines[pin_number];
+    uint64_t count;
+
+    line.requested = false;
+    line.direction = GPIOD_LINE_DIRECTION_INPUT;
+    line.event = GPIO_EVENT_NONE;
+    line.events.clear();
+
+    if (line.event_fd != -1 && ::read(line.event_fd, &count, sizeof(count)) == -1)
+    {
+        /* Nothing was queued. */
+    }
+}
+
+/**
+ * @brief Change the direction, bias and output value of a requested line without events at once.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param config New configuration. A bias of GPIOD_LINE_BIAS_AS_IS keeps the bias.
+ */
+void gpio_sim_chip_t::reconfigure(uint8_t pin_number, const gpio_config_t& config)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    line_t& line = this->lines[pin_number];
+    const uint8_t old_level = this->level(line);
+
+    /* Line must be requested without an event. */
+    assert(line.requested && line.event == GPIO_EVENT_NONE);
+
+    line.direction = config.direction;
+    line.output = config.output_value;
+
+    if (config.bias != GPIOD_LINE_BIAS_AS_IS)
+    {
+        line.bias = config.bias;
+    }
+
+    if (line.direction == GPIOD_LINE_DIRECTION_OUTPUT && line.output != old_level)
+    {
+        this->transitions.push_back({ pin_number, line.output, now() });
+    }
+}
+
+/**
+ * @brief Change the direction of a requested line without events. An output drives low, like
+ * set_direction_output() of libgpiod.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param direction GPIOD_LINE_DIRECTION_INPUT or GPIOD_LINE_DIRECTION_OUTPUT.
+ */
+void gpio_sim_chip_t::set_direction(uint8_t pin_number, uint8_t direction)
+{
+    gpio_config_t config;
+
+    config.direction = direction;
+    config.output_value = GPIO_STATE_LOW;
+
+    this->reconfigure(pin_number, config);
+}
+
+/**
+ * @brief Change the bias of a requested line.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param bias Bias, GPIOD_LINE_BIAS_AS_IS keeps the bias.
+ */
+void gpio_sim_chip_t::set_bias(uint8_t pin_number, uint8_t bias)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    if (bias != GPIOD_LINE_BIAS_AS_IS)
+    {
+        this->lines[pin_number].bias = bias;
+    }
+}
+
+/**
+ * @brief Drive a requested output.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+void gpio_sim_chip_t::write(uint8_t pin_number, uint8_t value)
+{
+    assert(gpio_is_valid(pin_number));
+
+    const std::chrono::nanoseconds timestamp = now();
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->writes++;
+    this->drive(pin_number, value, timestamp);
+}
+
+/**
+ * @brief Drive many requested outputs at the same instant, like a bulk request.
+ *
+ * @param mask Bit n set for GPIO pin n.
+ * @param values Bit n is the value of GPIO pin n.
+ */
+void gpio_sim_chip_t::write_pins(uint64_t mask, uint64_t values)
+{
+    const std::chrono::nanoseconds timestamp = now();
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->writes++;
+
+    for (uint8_t pin_number = 0u; pin_number < GPIO_PIN_COUNT; pin_number++)
+    {
+        if ((mask >> pin_number) & 1u)
+        {
+            this->drive(pin_number, (values >> pin_number) & 1u, timestamp);
+        }
+    }
+}
+
+/**
+ * @brief Read the level of a line: the value it drives as an output, otherwise the value of the input.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return uint8_t GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+uint8_t gpio_sim_chip_t::read(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->level(this->lines[pin_number]);
+}
+
+/**
+ * @brief Wait for an edge event of a line that reports edges.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param timeout Maximum time to wait.
+ * @return true if an event is waiting to be read, false on timeout.
+ */
+bool gpio_sim_chip_t::wait_event(uint8_t pin_number, std::chrono::nanoseconds timeout)
+{
+    pollfd descriptor = { this->get_event_fd(pin_number), POLLIN, 0 };
+    const int timeout_ms = (int)std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+
+    return poll(&descriptor, 1u, timeout_ms) > 0;
+}
+
+/**
+ * @brief Read the queued events of a line that reports edges, oldest first. Blocks until there is at least one.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param events Vector to append the events to.
+ * @param max_events Maximum number of events to read (default: MAX_EVENTS_PER_READ).
+ * @return uint8_t Number of events read.
+ */
+uint8_t gpio_sim_chip_t::read_events(uint8_t pin_number, std::vector<gpio_event_t>& events, uint8_t max_events)
+{
+    assert(gpio_is_valid(pin_number));
+    assert(max_events > 0u);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    line_t& line = this->lines[pin_number];
+    uint8_t count = 0u;
+
+    /* Another reader can take the events between a wakeup and taking the mutex, so the queue is checked with the
+       mutex held. */
+    this->event_queued.wait(lock, [&line]() { return !line.events.empty(); });
+
+    while (!line.events.empty() && count < max_events)
+    {
+        events.push_back(line.events.front());
+        line.events.pop_front();
+        count++;
+    }
+
+    /* Not readable any more once the queue is empty. */
+    if (line.events.empty())
+    {
+        uint64_t value;
+
+        if (::read(line.event_fd, &value, sizeof(value)) == -1)
+        {
+            /* Already read. */
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Get the file descriptor of a line that reports edges, readable while events are queued.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return int File descriptor.
+ */
+int gpio_sim_chip_t::get_event_fd(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    /* Line must be requested with an event. */
+    assert(this->lines[pin_number].event_fd != -1);
+
+    return this->lines[pin_number].event_fd;
+}
+
+/**
+ * @brief Drive an input from outside the chip now.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+void gpio_sim_chip_t::set_input(uint8_t pin_number, uint8_t value)
+{
+    this->set_input(pin_number, value, now());
+}
+
+/**
+ * @brief Drive an input from outside the chip. An edge queues an event with the timestamp if the line reports it.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ * @param timestamp Time of the change, must not be before the time of the previous change.
+ */
+void gpio_sim_chip_t::set_input(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp)
+{
+    assert(gpio_is_valid(pin_number));
+    assert(value == GPIO_STATE_HIGH || value == GPIO_STATE_LOW);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->change_input(pin_number, value, timestamp);
+}
+
+/**
+ * @brief Apply a waveform to an input at once, with the timestamps of the script, so the result does not depend
+ * on the scheduler.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param waveform Steps, in order of their offsets.
+ * @param start Time of offset 0.
+ */
+void gpio_sim_chip_t::play(uint8_t pin_number, const std::vector<gpio_sim_step_t>& waveform, std::chrono::nanoseconds start)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    for (const gpio_sim_step_t& step : waveform)
+    {
+        this->change_input(pin_number, step.value, start + step.offset);
+    }
+}
+
+/**
+ * @brief Apply a waveform to an input in real time: sleep until each step and stamp it with the time it happened,
+ * e.g. to measure the latency of code that waits for edges. Returns after the last step.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param waveform Steps, in order of their offsets.
+ */
+void gpio_sim_chip_t::play_realtime(uint8_t pin_number, const std::vector<gpio_sim_step_t>& waveform)
+{
+    const std::chrono::nanoseconds start = now();
+
+    for (const gpio_sim_step_t& step : waveform)
+    {
+        const std::chrono::nanoseconds time = start + step.offset;
+        const timespec until = { (time_t)(time.count() / 1000000000), (long)(time.count() % 1000000000) };
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, nullptr) != 0)
+        {
+            /* Interrupted by a signal. */
+        }
+
+        this->set_input(pin_number, step.value);
+    }
+}
+
+/**
+ * @brief Check whether a line is requested.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return true if the line is requested.
+ */
+bool gpio_sim_chip_t::is_requested(uint8_t pin_number)
+{
+    assert(gpio_is_valid(pin_number));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->lines[pin_number].requested;
+}
+
+/**
+ * @brief Get the level changes of all outputs so far, in the order they happened.
+ *
+ * @return std::vector<gpio_sim_transition_t> Transitions.
+ */
+std::vector<gpio_sim_transition_t> gpio_sim_chip_t::get_transitions()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->transitions;
+}
+
+/**
+ * @brief Get the level changes of one output so far, in the order they happened.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @return std::vector<gpio_sim_transition_t> Transitions.
+ */
+std::vector<gpio_sim_transition_t> gpio_sim_chip_t::get_transitions(uint8_t pin_number)
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    std::vector<gpio_sim_transition_t> result;
+
+    for (const gpio_sim_transition_t& transition : this->transitions)
+    {
+        if (transition.pin_number == pin_number)
+        {
+            result.push_back(transition);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Forget the recorded level changes.
+ */
+void gpio_sim_chip_t::clear_transitions()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    this->transitions.clear();
+}
+
+/**
+ * @brief Get the number of writes by the pins, also of values the outputs already had.
+ *
+ * @return uint64_t Number of writes.
+ */
+uint64_t gpio_sim_chip_t::get_writes()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    return this->writes;
+}
+
+/**
+ * @brief Get the time of CLOCK_MONOTONIC, the clock of the timestamps.
+ *
+ * @return std::chrono::nanoseconds Time.
+ */
+std::chrono::nanoseconds gpio_sim_chip_t::now()
+{
+    timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+/**
+ * @brief Get the level of a line. Mutex must be held.
+ *
+ * @param line The line.
+ * @return uint8_t GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ */
+uint8_t gpio_sim_chip_t::level(const line_t& line)
+{
+    if (line.requested && line.direction == GPIOD_LINE_DIRECTION_OUTPUT)
+    {
+        return line.output;
+    }
+
+    if (line.external)
+    {
+        return line.input;
+    }
+
+    return line.bias == GPIOD_LINE_BIAS_PULL_UP ? GPIO_STATE_HIGH : GPIO_STATE_LOW;
+}
+
+/**
+ * @brief Change the value the test drives on an input, and queue an event for an edge the line reports.
+ * Mutex must be held.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ * @param timestamp Time of the change.
+ */
+void gpio_sim_chip_t::change_input(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp)
+{
+    line_t& line = this->lines[pin_number];
+    const uint8_t old_level = this->level(line);
+
+    line.external = true;
+    line.input = value;
+
+    const uint8_t new_level = this->level(line);
+
+    if (new_level == old_level || line.event == GPIO_EVENT_NONE)
+    {
+        return;
+    }
+
+    const uint8_t edge = new_level == GPIO_STATE_HIGH ? GPIO_EVENT_RISING_EDGE : GPIO_EVENT_FALLING_EDGE;
+
+    if (line.event == GPIO_EVENT_BOTH_EDGES || line.event == edge)
+    {
+        const uint64_t count = 1u;
+
+        line.events.push_back({ pin_number, edge, timestamp });
+        this->event_queued.notify_all();
+
+        if (::write(line.event_fd, &count, sizeof(count)) == -1)
+        {
+            /* The counter is full, the line is readable anyway. */
+        }
+    }
+}
+
+/**
+ * @brief Change the value an output drives, and record the transition if its level changes. Mutex must be held.
+ *
+ * @param pin_number Number of the GPIO pin.
+ * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+ * @param timestamp Time of the change.
+ */
+void gpio_sim_chip_t::drive(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp)
+{
+    line_t& line = this->lines[pin_number];
+
+    /* Line must be requested as output. */
+    assert(line.requested && line.direction == GPIOD_LINE_DIRECTION_OUTPUT);
+
+    if (line.output != value)
+    {
+        line.output = value;
+        this->transitions.push_back({ pin_number, value, timestamp });
+    }
+}
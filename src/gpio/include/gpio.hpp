@@ -0,0 +1,136 @@
+/**
+ * @file gpio.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include "gpio_pin.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief A GPIO pin of which the number, direction and bias are known at compile time, driven through the
+ * registers of /dev/gpiomem. Driving an input or reading an output does not compile, so accesses need no
+ * checks: set_value() is a single store and get_value() a single load, with the register and bit known at
+ * compile time. The pin is configured when it is constructed.
+ *
+ * @tparam PIN Number of the GPIO pin.
+ * @tparam DIRECTION GPIOD_LINE_DIRECTION_INPUT or GPIOD_LINE_DIRECTION_OUTPUT.
+ * @tparam BIAS GPIOD_LINE_BIAS_AS_IS, GPIOD_LINE_BIAS_DISABLE, GPIOD_LINE_BIAS_PULL_UP or GPIOD_LINE_BIAS_PULL_DOWN.
+ */
+template <uint8_t PIN, uint8_t DIRECTION, uint8_t BIAS = GPIOD_LINE_BIAS_AS_IS>
+class gpio_t
+{
+    static_assert(gpio_is_valid(PIN), "Pin number must fall within the GPIO range");
+    static_assert(DIRECTION == GPIOD_LINE_DIRECTION_INPUT || DIRECTION == GPIOD_LINE_DIRECTION_OUTPUT, "Direction must be input or output");
+    static_assert(BIAS >= GPIOD_LINE_BIAS_AS_IS && BIAS <= GPIOD_LINE_BIAS_PULL_DOWN, "Bias must be valid");
+public:
+    static constexpr uint8_t PIN_NUMBER = PIN;
+    static constexpr bool IS_OUTPUT = DIRECTION == GPIOD_LINE_DIRECTION_OUTPUT;
+
+    /**
+     * @brief Construct a new gpio_t object and configure the pin.
+     *
+     * @param output_value Value an output drives from the start.
+     * @param registers Registers of the pin (default: the registers of gpio_registers()).
+     */
+    gpio_t(uint8_t output_value = GPIO_STATE_LOW, gpio_registers_t& registers = gpio_registers()) :
+        registers(registers.get_registers())
+    {
+        /* Outputs get their value before their function and inputs their pull before their function, so the pin
+           does not glitch. */
+        if constexpr (IS_OUTPUT)
+        {
+            registers.write_pin(PIN, output_value);
+            registers.set_function(PIN, GPIO_FUNCTION_OUTPUT);
+            registers.set_pull(PIN, BIAS);
+        }
+        else
+        {
+            registers.set_pull(PIN, BIAS);
+            registers.set_function(PIN, GPIO_FUNCTION_INPUT);
+        }
+    }
+
+    /**
+     * @brief Drive the pin.
+     *
+     * @param value GPIO_STATE_HIGH or GPIO_STATE_LOW.
+     */
+    void set_value(uint8_t value)
+    {
+        static_assert(IS_OUTPUT, "Only an output can be driven");
+
+        this->registers[(value == GPIO_STATE_HIGH ? gpio_registers_t::GPSET0 : gpio_registers_t::GPCLR0) + OFFSET] = BIT;
+    }
+
+    /**
+     * @brief Drive the pin high.
+     */
+    void set_high()
+    {
+        static_assert(IS_OUTPUT, "Only an output can be driven");
+
+        this->registers[gpio_registers_t::GPSET0 + OFFSET] = BIT;
+    }
+
+    /**
+     * @brief Drive the pin low.
+     */
+    void set_low()
+    {
+        static_assert(IS_OUTPUT, "Only an output can be driven");
+
+        this->registers[gpio_registers_t::GPCLR0 + OFFSET] = BIT;
+    }
+
+    /**
+     * @brief Read the level of the pin.
+     *
+     * @return uint8_t GPIO_STATE_HIGH or GPIO_STATE_LOW.
+     */
+    uint8_t get_value()
+    {
+        static_assert(!IS_OUTPUT, "Only an input can be read");
+
+        return (this->registers[gpio_registers_t::GPLEV0 + OFFSET] >> (PIN % 32u)) & 1u;
+    }
+private:
+    /* Register of the pin in the GPSETn, GPCLRn and GPLEVn banks, and its bit. */
+    static constexpr uint32_t OFFSET = PIN / 32u;
+    static constexpr uint32_t BIT = 1u << (PIN % 32u);
+
+    volatile uint32_t* const registers;
+};
+
+/**
+ * @brief Check that typed pins use different GPIO pins, e.g. static_assert(gpio_distinct<led_t, button_t>(), "...").
+ *
+ * @tparam GPIOS gpio_t types.
+ * @return true if no two types use the same pin.
+ */
+template <typename... GPIOS>
+constexpr bool gpio_distinct()
+{
+    uint64_t used = 0u;
+
+    for (const uint8_t pin_number : { GPIO_PIN_COUNT, GPIOS::PIN_NUMBER... })
+    {
+        if (pin_number != GPIO_PIN_COUNT)
+        {
+            if ((used >> pin_number) & 1u)
+            {
+                return false;
+            }
+
+            used |= 1ull << pin_number;
+        }
+    }
+
+    return true;
+}
+
+} /* pi_zero_peripherals */
@@ -0,0 +1,91 @@
+/**
+ * @file gpio_capture.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <thread>
+
+#include "gpio_pin.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Captures the edge events of a pin, with the timestamps of the kernel, into a lock-free ring buffer.
+ * A capture thread produces the events, one other thread consumes them with pop().
+ */
+class gpio_capture_t
+{
+public:
+    gpio_capture_t(gpio_pin_t& pin, uint32_t capacity = 4096u);
+    ~gpio_capture_t();
+
+    void start();
+    void stop();
+
+    bool pop(gpio_event_t& event);
+    uint32_t pop(gpio_event_t* events, uint32_t count);
+
+    uint64_t get_captured();
+    uint64_t get_dropped();
+private:
+    gpio_pin_t& pin;
+    /* Ring buffer, the capacity is a power of two. */
+    std::vector<gpio_event_t> ring;
+    const uint32_t mask;
+    /* Written by the consumer and the capture thread respectively, on separate cache lines. */
+    alignas(64) std::atomic<uint32_t> head;
+    alignas(64) std::atomic<uint32_t> tail;
+    std::atomic<uint64_t> captured;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> running;
+    std::thread thread;
+
+    void capture();
+};
+
+/**
+ * @brief Measures a pulse train over a sliding window of time: pulse width, period, duty cycle and frequency.
+ * A cycle starts at a rising edge. With only rising edges the period and frequency are still measured.
+ * The window moves with every edge and with advance(), so the measurements drop to 0 when the signal stops.
+ */
+class gpio_pulse_analyzer_t
+{
+public:
+    gpio_pulse_analyzer_t(std::chrono::nanoseconds window = std::chrono::seconds(1));
+
+    void add(const gpio_event_t& event);
+    void advance(std::chrono::nanoseconds now);
+    void reset();
+
+    uint32_t get_cycles();
+    std::chrono::nanoseconds get_last_pulse_width();
+    std::chrono::nanoseconds get_pulse_width();
+    std::chrono::nanoseconds get_period();
+    double get_duty_cycle();
+    double get_frequency();
+private:
+    struct cycle_t
+    {
+        std::chrono::nanoseconds start;
+        std::chrono::nanoseconds period;
+        std::chrono::nanoseconds high_time;
+    };
+
+    const std::chrono::nanoseconds window;
+    std::deque<cycle_t> cycles;
+    /* Sums over the cycles in the window. */
+    std::chrono::nanoseconds period_sum;
+    std::chrono::nanoseconds high_time_sum;
+    bool seen_rising;
+    bool seen_falling;
+    std::chrono::nanoseconds last_rising;
+    std::chrono::nanoseconds last_pulse_width;
+};
+
+} /* pi_zero_peripherals */
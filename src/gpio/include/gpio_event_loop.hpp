@@ -0,0 +1,56 @@
+/**
+ * @file gpio_event_loop.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "gpio_pin.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Waits for edge events of many GPIO pins with one epoll instance and dispatches them to callbacks,
+ * all from the thread that runs the loop. Sleeps in the kernel while no edges arrive.
+ */
+class gpio_event_loop_t
+{
+public:
+    using callback_t = std::function<void(const gpio_event_t&)>;
+
+    /* Maximum number of pins that are reported ready by one wakeup. */
+    static constexpr uint8_t MAX_READY = 32u;
+
+    gpio_event_loop_t();
+    ~gpio_event_loop_t();
+
+    void add(gpio_pin_t& pin, callback_t callback);
+    void remove(gpio_pin_t& pin);
+
+    uint32_t run_once(int timeout_ms = -1);
+    void run();
+    void stop();
+    void reset();
+private:
+    struct registration_t
+    {
+        gpio_pin_t& pin;
+        callback_t callback;
+    };
+
+    int epoll_fd;
+    /* Written by stop() to wake up the loop from another thread. */
+    int wake_fd;
+    std::atomic<bool> stopped;
+    std::vector<std::unique_ptr<registration_t>> registrations;
+    /* Buffer for the events of one pin, kept to avoid an allocation per wakeup. */
+    std::vector<gpio_event_t> events;
+};
+
+} /* pi_zero_peripherals */
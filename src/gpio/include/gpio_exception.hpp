@@ -0,0 +1,26 @@
+/**
+ * @file gpio_exception.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <stdexcept>
+
+namespace pi_zero_peripherals
+{
+
+class gpio_event_exception: public std::runtime_error
+{
+public:
+    gpio_event_exception(const std::string& message);
+};
+
+class gpio_register_exception: public std::runtime_error
+{
+public:
+    gpio_register_exception(const std::string& message);
+};
+
+} /* pi_zero_peripherals */
@@ -8,8 +8,13 @@
 
 #pragma once
 
+#include <chrono>
 #include <gpiod.hpp>
 #include <stdint.h>
+#include <vector>
+
+#include "gpio_registers.hpp"
+#include "gpio_registry.hpp"
 
 namespace pi_zero_peripherals
 {
@@ -21,16 +26,63 @@ enum : uint8_t
     GPIO_STATE_HIGH = 1u
 };
 
+/* GPIO edge events. */
+enum : uint8_t
+{
+    GPIO_EVENT_NONE         = 0u,
+    GPIO_EVENT_RISING_EDGE  = 1u,
+    GPIO_EVENT_FALLING_EDGE = 2u,
+    GPIO_EVENT_BOTH_EDGES   = 3u
+};
+
+/* GPIO backends. */
+enum : uint8_t
+{
+    GPIO_BACKEND_DEFAULT = 0u,  /* The backend set with gpio_set_default_backend(). */
+    GPIO_BACKEND_CHARDEV = 1u,  /* The GPIO character device through libgpiod: an ioctl per access, supports events. */
+    GPIO_BACKEND_GPIOMEM = 2u,  /* The registers mapped from /dev/gpiomem: a memory access, no events. */
+    GPIO_BACKEND_SIMULATED = 3u /* The chip set with gpio_set_sim_chip(), in-process, for tests. */
+};
+
 /* GPIO configuration. */
 struct gpio_config_t
 {
     uint8_t direction    = GPIOD_LINE_DIRECTION_INPUT;
     uint8_t bias         = GPIOD_LINE_BIAS_AS_IS;
     uint8_t output_value = 0u;
+    uint8_t event        = GPIO_EVENT_NONE; /* Edges to report, the pin is an input if not GPIO_EVENT_NONE. */
+    uint8_t backend      = GPIO_BACKEND_DEFAULT;
 };
 
+/* Edge event of a GPIO pin. */
+struct gpio_event_t
+{
+    uint8_t pin_number;
+    uint8_t edge;                       /* GPIO_EVENT_RISING_EDGE or GPIO_EVENT_FALLING_EDGE. */
+    std::chrono::nanoseconds timestamp; /* Time of the edge, taken by the kernel. */
+};
+
+/* Writes to an output. A write of the value the output already drives is suppressed. */
+struct gpio_write_counters_t
+{
+    uint64_t writes     = 0u;
+    uint64_t suppressed = 0u;
+};
+
+class gpio_sim_chip_t;
+
+gpiod::chip& gpio_chip();
+std::bitset<32> gpio_bias_flags(uint8_t bias);
+gpio_registers_t& gpio_registers();
+void gpio_set_registers(gpio_registers_t* registers);
+gpio_sim_chip_t& gpio_sim_chip();
+void gpio_set_sim_chip(gpio_sim_chip_t* sim_chip);
+void gpio_set_default_backend(uint8_t backend);
+uint8_t gpio_get_default_backend();
+
 /**
  * @brief Represents a single GPIO pin.
+ * The line is looked up when the pin is initialised, so pins that are not used cost nothing.
  */
 class gpio_pin_t
 {
@@ -44,8 +96,17 @@ public:
 
     void set_direction(uint8_t direction);
     void set_bias(uint8_t bias);
+    void reconfigure(const gpio_config_t& config);
     void set_value(uint8_t value);
+    void force_value(uint8_t value);
     uint8_t get_value();
+    gpio_write_counters_t get_write_counters();
+
+    bool wait_event(std::chrono::nanoseconds timeout);
+    gpio_event_t read_event();
+    uint8_t read_events(std::vector<gpio_event_t>& events);
+    int get_event_fd();
+    uint8_t get_pin_number();
 private:
     const uint8_t pin_number;
     const std::string consumer;
@@ -53,6 +114,13 @@ private:
     gpiod::line gpio_line;
     std::bitset<32> flags;
     uint8_t event;
+    uint8_t backend;
+    gpio_registers_t* registers;
+    gpio_sim_chip_t* sim_chip;
+    /* Shadow of the value the pin drives, valid if output_known is set. */
+    uint8_t output_value;
+    bool output_known;
+    gpio_write_counters_t write_counters;
 };
 
 extern gpio_pin_t GPIO0;
@@ -0,0 +1,61 @@
+/**
+ * @file gpio_port.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <vector>
+
+#include "gpio_pin.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Represents a group of GPIO pins that are requested together and read or written with a single request.
+ * Values are bitmasks: bit i is the i-th pin given to the constructor.
+ */
+class gpio_port_t
+{
+public:
+    static constexpr uint8_t MAX_PINS = 32u;
+
+    gpio_port_t(std::initializer_list<uint8_t> pin_numbers);
+    gpio_port_t(const std::vector<uint8_t>& pin_numbers);
+    ~gpio_port_t();
+
+    void initialise(std::string consumer_string = "default");
+    void initialise(const gpio_config_t& config, std::string consumer_string = "default");
+
+    void reconfigure(const gpio_config_t& config);
+
+    void set_values(uint32_t values);
+    void set_values(uint32_t values, uint32_t mask);
+    void force_values(uint32_t values);
+    uint32_t get_values();
+    uint8_t get_size();
+    gpio_write_counters_t get_write_counters();
+private:
+    const std::vector<uint8_t> pin_numbers;
+    uint8_t initialised;
+    gpiod::line_bulk gpio_lines;
+    /* Last values written, so that set_values() with a mask keeps the other pins and repeated values are not
+       written again. Only valid for writes if output_known is set. */
+    uint32_t output_values;
+    bool output_known;
+    gpio_write_counters_t write_counters;
+    /* Buffer for the values of set_values(), kept to avoid an allocation per call. */
+    std::vector<int> buffer;
+    uint8_t backend;
+    gpio_registers_t* registers;
+    gpio_sim_chip_t* sim_chip;
+    /* Flags of the request, kept so that reconfigure() with GPIOD_LINE_BIAS_AS_IS keeps the bias. */
+    std::bitset<32> flags;
+
+    uint64_t to_gpio_mask(uint32_t values);
+};
+
+} /* pi_zero_peripherals */
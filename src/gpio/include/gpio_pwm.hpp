@@ -0,0 +1,75 @@
+/**
+ * @file gpio_pwm.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "gpio_port.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Timing of the PWM thread. Jitter is how late an edge was written compared to when it was due. */
+struct gpio_pwm_statistics_t
+{
+    uint64_t periods = 0u;
+    uint64_t writes  = 0u;                          /* Bulk writes, one per distinct edge time. */
+    std::chrono::nanoseconds max_jitter{0};
+    std::chrono::nanoseconds mean_jitter{0};
+    bool realtime = false;                          /* True if the thread got a realtime priority. */
+};
+
+/**
+ * @brief Software PWM on the pins of a port, all driven by one thread.
+ * Every period the edges of all channels are one sorted timeline, and all pins that change at the same time
+ * are written together with one bulk write.
+ */
+class gpio_pwm_t
+{
+public:
+    gpio_pwm_t(gpio_port_t& port, std::chrono::nanoseconds period = std::chrono::milliseconds(10));
+    ~gpio_pwm_t();
+
+    void set_duty_cycle(uint8_t channel, double duty_cycle);
+    void start(int priority = 50);
+    void stop();
+
+    gpio_pwm_statistics_t get_statistics();
+private:
+    /* Writes to the port at an offset from the start of the period. */
+    struct edge_t
+    {
+        std::chrono::nanoseconds offset;
+        uint32_t values;
+    };
+
+    gpio_port_t& port;
+    const std::chrono::nanoseconds period;
+    std::atomic<bool> running;
+    std::thread thread;
+
+    /* On time of every channel, written by set_duty_cycle() and taken by the thread at a period boundary. */
+    std::mutex pending_mutex;
+    std::array<std::chrono::nanoseconds, gpio_port_t::MAX_PINS> pending_on_times;
+    bool pending_changed;
+
+    /* Only used by the thread. */
+    std::array<std::chrono::nanoseconds, gpio_port_t::MAX_PINS> on_times;
+    std::array<edge_t, gpio_port_t::MAX_PINS + 1u> timeline;
+    uint8_t timeline_size;
+
+    std::mutex statistics_mutex;
+    gpio_pwm_statistics_t statistics;
+
+    void build_timeline();
+    void run(int priority);
+};
+
+} /* pi_zero_peripherals */
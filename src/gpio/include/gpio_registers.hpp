@@ -0,0 +1,64 @@
+/**
+ * @file gpio_registers.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+namespace pi_zero_peripherals
+{
+
+/* GPIO pin functions of the GPFSELn registers. */
+enum : uint8_t
+{
+    GPIO_FUNCTION_INPUT  = 0b000u,
+    GPIO_FUNCTION_OUTPUT = 0b001u
+};
+
+/**
+ * @brief The GPIO register block of the BCM2835, memory-mapped from /dev/gpiomem.
+ * Writes to GPSETn and GPCLRn only affect the pins of which the bit is set, so many pins change with one store
+ * and no read-modify-write. Any file of at least REGISTERS_SIZE bytes can stand in for /dev/gpiomem.
+ */
+class gpio_registers_t
+{
+public:
+    static constexpr uint32_t REGISTERS_SIZE = 4096u;
+
+    /* Register offsets in 32-bit words. */
+    static constexpr uint32_t GPFSEL0   = 0x00u / 4u;
+    static constexpr uint32_t GPSET0    = 0x1Cu / 4u;
+    static constexpr uint32_t GPCLR0    = 0x28u / 4u;
+    static constexpr uint32_t GPLEV0    = 0x34u / 4u;
+    static constexpr uint32_t GPPUD     = 0x94u / 4u;
+    static constexpr uint32_t GPPUDCLK0 = 0x98u / 4u;
+
+    gpio_registers_t(const std::string& file_name = "/dev/gpiomem");
+    ~gpio_registers_t();
+
+    /* Owns the mapping, which must be unmapped once. */
+    gpio_registers_t(const gpio_registers_t&) = delete;
+    gpio_registers_t& operator=(const gpio_registers_t&) = delete;
+
+    void set_function(uint8_t pin_number, uint8_t function);
+    uint8_t get_function(uint8_t pin_number);
+    void set_functions(uint64_t mask, uint8_t function);
+    void set_pull(uint8_t pin_number, uint8_t bias);
+    void set_pulls(uint64_t mask, uint8_t bias);
+
+    void set_pins(uint64_t mask);
+    void clear_pins(uint64_t mask);
+    void write_pin(uint8_t pin_number, uint8_t value);
+    uint64_t get_levels();
+    uint8_t get_level(uint8_t pin_number);
+
+    volatile uint32_t* get_registers();
+private:
+    volatile uint32_t* registers;
+};
+
+} /* pi_zero_peripherals */
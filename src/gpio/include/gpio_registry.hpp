@@ -0,0 +1,82 @@
+/**
+ * @file gpio_registry.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace pi_zero_peripherals
+{
+
+/* Number of GPIO pins of the BCM2835. */
+static constexpr uint8_t GPIO_PIN_COUNT = 54u;
+/* Header pin of a GPIO pin that is not on the 40-pin header. */
+static constexpr uint8_t GPIO_NO_HEADER_PIN = 0u;
+
+/* Static information about a GPIO pin. */
+struct gpio_pin_info_t
+{
+    uint8_t pin_number;
+    uint8_t header_pin;         /* Pin of the 40-pin header, GPIO_NO_HEADER_PIN if it is not on the header. */
+    const char* name;           /* Name of the most common alternative function on the Pi Zero W. */
+};
+
+/* All GPIO pins, indexed by pin number. */
+inline constexpr gpio_pin_info_t GPIO_PINS[GPIO_PIN_COUNT] = {
+    {  0u, 27u, "ID_SD"     }, {  1u, 28u, "ID_SC"     }, {  2u,  3u, "SDA1"      }, {  3u,  5u, "SCL1"      },
+    {  4u,  7u, "GPCLK0"    }, {  5u, 29u, "GPIO5"     }, {  6u, 31u, "GPIO6"     }, {  7u, 26u, "SPI0_CE1"  },
+    {  8u, 24u, "SPI0_CE0"  }, {  9u, 21u, "SPI0_MISO" }, { 10u, 19u, "SPI0_MOSI" }, { 11u, 23u, "SPI0_SCLK" },
+    { 12u, 32u, "PWM0"      }, { 13u, 33u, "PWM1"      }, { 14u,  8u, "TXD0"      }, { 15u, 10u, "RXD0"      },
+    { 16u, 36u, "GPIO16"    }, { 17u, 11u, "GPIO17"    }, { 18u, 12u, "PCM_CLK"   }, { 19u, 35u, "PCM_FS"    },
+    { 20u, 38u, "PCM_DIN"   }, { 21u, 40u, "PCM_DOUT"  }, { 22u, 15u, "GPIO22"    }, { 23u, 16u, "GPIO23"    },
+    { 24u, 18u, "GPIO24"    }, { 25u, 22u, "GPIO25"    }, { 26u, 37u, "GPIO26"    }, { 27u, 13u, "GPIO27"    },
+    { 28u,  0u, "GPIO28"    }, { 29u,  0u, "GPIO29"    }, { 30u,  0u, "GPIO30"    }, { 31u,  0u, "GPIO31"    },
+    { 32u,  0u, "GPIO32"    }, { 33u,  0u, "GPIO33"    }, { 34u,  0u, "SD0_CLK"   }, { 35u,  0u, "SD0_CMD"   },
+    { 36u,  0u, "SD0_DAT0"  }, { 37u,  0u, "SD0_DAT1"  }, { 38u,  0u, "SD0_DAT2"  }, { 39u,  0u, "SD0_DAT3"  },
+    { 40u,  0u, "PWM0_OUT"  }, { 41u,  0u, "GPIO41"    }, { 42u,  0u, "GPIO42"    }, { 43u,  0u, "GPIO43"    },
+    { 44u,  0u, "GPIO44"    }, { 45u,  0u, "PWM1_OUT"  }, { 46u,  0u, "GPIO46"    }, { 47u,  0u, "ACT_LED"   },
+    { 48u,  0u, "SD1_CLK"   }, { 49u,  0u, "SD1_CMD"   }, { 50u,  0u, "SD1_DAT0"  }, { 51u,  0u, "SD1_DAT1"  },
+    { 52u,  0u, "SD1_DAT2"  }, { 53u,  0u, "SD1_DAT3"  }
+};
+
+/**
+ * @brief Check whether a pin number exists.
+ */
+constexpr bool gpio_is_valid(uint8_t pin_number)
+{
+    return pin_number < GPIO_PIN_COUNT;
+}
+
+/**
+ * @brief Check whether a GPIO pin is on the 40-pin header.
+ */
+constexpr bool gpio_is_on_header(uint8_t pin_number)
+{
+    return gpio_is_valid(pin_number) && GPIO_PINS[pin_number].header_pin != GPIO_NO_HEADER_PIN;
+}
+
+/**
+ * @brief Get the GPIO pin on a pin of the 40-pin header.
+ *
+ * @return GPIO pin number, GPIO_PIN_COUNT for power, ground and pins that do not exist.
+ */
+constexpr uint8_t gpio_from_header_pin(uint8_t header_pin)
+{
+    for (uint8_t pin_number = 0u; pin_number < GPIO_PIN_COUNT; pin_number++)
+    {
+        if (header_pin != GPIO_NO_HEADER_PIN && GPIO_PINS[pin_number].header_pin == header_pin)
+        {
+            return pin_number;
+        }
+    }
+
+    return GPIO_PIN_COUNT;
+}
+
+static_assert(gpio_from_header_pin(11u) == 17u, "Header pin 11 is GPIO17");
+static_assert(gpio_from_header_pin(1u) == GPIO_PIN_COUNT, "Header pin 1 is 3.3 V");
+
+} /* pi_zero_peripherals */
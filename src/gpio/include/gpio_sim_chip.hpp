@@ -0,0 +1,99 @@
+/**
+ * @file gpio_sim_chip.hpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @date 18-10-2026
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "gpio_pin.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/* Level change of a simulated output. */
+struct gpio_sim_transition_t
+{
+    uint8_t pin_number;
+    uint8_t value;
+    std::chrono::nanoseconds timestamp; /* CLOCK_MONOTONIC, like the timestamps of edge events. */
+};
+
+/* Step of a scripted input waveform: the input has the value from the offset on. */
+struct gpio_sim_step_t
+{
+    std::chrono::nanoseconds offset;
+    uint8_t value;
+};
+
+/**
+ * @brief In-process GPIO chip for pins with the GPIO_BACKEND_SIMULATED backend, to test code that uses GPIO pins
+ * without hardware. Inputs follow levels that the test sets or scripts, edges on them queue events like the
+ * kernel does, and every level change of an output is recorded with its time. All methods are thread-safe.
+ */
+class gpio_sim_chip_t
+{
+public:
+    /* Maximum number of events returned by one read, like the kernel. */
+    static constexpr uint8_t MAX_EVENTS_PER_READ = 16u;
+
+    gpio_sim_chip_t();
+    ~gpio_sim_chip_t();
+
+    /* Used by gpio_pin_t and gpio_port_t. */
+    void request(uint8_t pin_number, const gpio_config_t& config);
+    void release(uint8_t pin_number);
+    void reconfigure(uint8_t pin_number, const gpio_config_t& config);
+    void set_direction(uint8_t pin_number, uint8_t direction);
+    void set_bias(uint8_t pin_number, uint8_t bias);
+    void write(uint8_t pin_number, uint8_t value);
+    void write_pins(uint64_t mask, uint64_t values);
+    uint8_t read(uint8_t pin_number);
+    bool wait_event(uint8_t pin_number, std::chrono::nanoseconds timeout);
+    uint8_t read_events(uint8_t pin_number, std::vector<gpio_event_t>& events, uint8_t max_events = MAX_EVENTS_PER_READ);
+    int get_event_fd(uint8_t pin_number);
+
+    /* Used by tests. */
+    void set_input(uint8_t pin_number, uint8_t value);
+    void set_input(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp);
+    void play(uint8_t pin_number, const std::vector<gpio_sim_step_t>& waveform, std::chrono::nanoseconds start);
+    void play_realtime(uint8_t pin_number, const std::vector<gpio_sim_step_t>& waveform);
+    bool is_requested(uint8_t pin_number);
+    std::vector<gpio_sim_transition_t> get_transitions();
+    std::vector<gpio_sim_transition_t> get_transitions(uint8_t pin_number);
+    void clear_transitions();
+    uint64_t get_writes();
+
+    static std::chrono::nanoseconds now();
+private:
+    struct line_t
+    {
+        bool requested      = false;
+        uint8_t direction   = GPIOD_LINE_DIRECTION_INPUT;
+        uint8_t bias        = GPIOD_LINE_BIAS_AS_IS;
+        uint8_t event       = GPIO_EVENT_NONE;
+        uint8_t output      = GPIO_STATE_LOW;  /* Value the line drives as an output. */
+        bool external       = false;           /* Whether the test drives the input. */
+        uint8_t input       = GPIO_STATE_LOW;  /* Value the test drives. */
+        int event_fd        = -1;              /* Readable while events are queued. */
+        std::deque<gpio_event_t> events;
+    };
+
+    std::mutex mutex;
+    /* Notified when an event is queued on any line. */
+    std::condition_variable event_queued;
+    line_t lines[GPIO_PIN_COUNT];
+    std::vector<gpio_sim_transition_t> transitions;
+    /* Number of writes by the pins, also of values the outputs already had. */
+    uint64_t writes;
+
+    uint8_t level(const line_t& line);
+    void change_input(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp);
+    void drive(uint8_t pin_number, uint8_t value, std::chrono::nanoseconds timestamp);
+};
+
+} /* pi_zero_peripherals */
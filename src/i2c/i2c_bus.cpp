@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <iostream>
 #include <string>
+#include <sys/ioctl.h>
 
 #include "../../lib/libi2c/i2c.h"
 #include "include/i2c_bus.hpp"
@@ -23,8 +24,8 @@ using namespace pi_zero_peripherals;
  */
 i2c_bus_t::i2c_bus_t(uint8_t bus_number) :
     initialised(0u),
-    bus_number(bus_number),
-    bus_fd(-1)
+    bus_fd(-1),
+    bus_number(bus_number)
 {}
 
 /**
@@ -57,3 +58,48 @@ void i2c_bus_t::initialise()
 
     this->initialised = 1u;
 }
+
+/**
+ * @brief Read from a device on the bus using libi2c.
+ *
+ * @param device Device to read from.
+ * @param internal_address Address of the internal register to read from.
+ * @param buffer Buffer to store the read data into.
+ * @param size Size of the data to read.
+ * @return ssize_t Number of bytes read, or -1 on failure.
+ */
+ssize_t i2c_bus_t::read(const I2CDevice* device, uint32_t internal_address, uint8_t* buffer, size_t size)
+{
+    return i2c_ioctl_read(device, internal_address, buffer, size);
+}
+
+/**
+ * @brief Write to a device on the bus using libi2c.
+ *
+ * @param device Device to write to.
+ * @param internal_address Address of the internal register to write to.
+ * @param data Data to write.
+ * @param size Size of the data to write.
+ * @return ssize_t Number of bytes written, or -1 on failure.
+ */
+ssize_t i2c_bus_t::write(const I2CDevice* device, uint32_t internal_address, const uint8_t* data, size_t size)
+{
+    return i2c_ioctl_write(device, internal_address, data, size);
+}
+
+/**
+ * @brief Perform a combined transfer of I2C messages, without a stop condition between the messages.
+ *
+ * @param messages Messages to transfer.
+ * @param count Number of messages.
+ * @return int Number of messages transferred, or -1 on failure.
+ */
+int i2c_bus_t::transfer(struct i2c_msg* messages, uint32_t count)
+{
+    struct i2c_rdwr_ioctl_data transfer = {
+        .msgs  = messages,
+        .nmsgs = count
+    };
+
+    return ioctl(this->bus_fd, I2C_RDWR, &transfer);
+}
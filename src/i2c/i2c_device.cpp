@@ -23,8 +23,8 @@ using namespace pi_zero_peripherals;
  * @param flags I2C flags (default: 0u).
  */
 i2c_device_t::i2c_device_t(i2c_bus_t& bus, uint8_t address, uint8_t internal_address_bytes, uint16_t flags) :
-    bus(bus),
     flags(flags),
+    bus(bus),
     device({
         .bus         = bus.bus_fd,
         .addr        = address,
@@ -37,7 +37,7 @@ i2c_device_t::i2c_device_t(i2c_bus_t& bus, uint8_t address, uint8_t internal_add
 {}
 
 /**
- * @brief Read from the I2C device using libi2c.
+ * @brief Read from the I2C device using libi2c (or the simulated bus).
  *
  * @param buffer Buffer to store the read data into.
  * @param size Size of the data to read.
@@ -53,14 +53,14 @@ void i2c_device_t::i2c_read(uint8_t* buffer, uint8_t size, uint32_t internal_add
     this->device.bus = this->bus.bus_fd;
 
     /* Read from I2C device into buffer. */
-    if(i2c_ioctl_read(&this->device, internal_address, buffer, size) == -1)
+    if(this->bus.read(&this->device, internal_address, buffer, size) == -1)
     {
         throw i2c_read_exception("unable to read from I2C device");
     }
 }
 
 /**
- * @brief Write to the I2C device using libi2c.
+ * @brief Write to the I2C device using libi2c (or the simulated bus).
  *
  * @param data Data to write to the device.
  * @param size Size of the data to write.
@@ -76,7 +76,33 @@ void i2c_device_t::i2c_write(uint8_t* data, uint8_t size, uint32_t internal_addr
     this->device.bus = this->bus.bus_fd;
 
     /* Write data from I2C device. */
-    if(i2c_ioctl_write(&this->device, internal_address, data, size) == -1)
+    if(this->bus.write(&this->device, internal_address, data, size) == -1)
+    {
+        throw i2c_write_exception("unable to write to I2C device");
+    }
+}
+
+/**
+ * @brief Write data to the I2C device in a single I2C message.
+ * Unlike i2c_write, the data is not split into pages and no internal address is prepended,
+ * so the device receives one uninterrupted burst.
+ *
+ * @param data Data to write to the device.
+ * @param size Size of the data to write.
+ */
+void i2c_device_t::i2c_write_message(const uint8_t* data, uint16_t size)
+{
+    assert(this->bus.initialised == 1u);
+
+    struct i2c_msg message = {
+        .addr  = this->device.addr,
+        .flags = this->flags,
+        .len   = size,
+        .buf   = const_cast<uint8_t*>(data)
+    };
+
+    /* Write data to I2C device. */
+    if(this->bus.transfer(&message, 1u) == -1)
     {
         throw i2c_write_exception("unable to write to I2C device");
     }
@@ -0,0 +1,150 @@
+/**
+ * @file i2c_sim_bus.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the i2c_sim_bus_t class, a simulated I2C bus for testing devices without hardware.
+ *        Messages are split up the same way libi2c does it, so the transactions match the real bus.
+ * @date 18-10-2026
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <vector>
+
+#include "include/i2c_sim_bus.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new i2c_sim_bus_t object without devices.
+ *
+ * @param bus_number Number of the simulated bus. Only used for identification.
+ */
+i2c_sim_bus_t::i2c_sim_bus_t(uint8_t bus_number) :
+    i2c_bus_t(bus_number),
+    transactions(0u),
+    bytes(0u)
+{}
+
+/**
+ * @brief Destroy the i2c_sim_bus_t object. There is no file to close.
+ */
+i2c_sim_bus_t::~i2c_sim_bus_t()
+{
+    this->initialised = 0u;
+}
+
+/**
+ * @brief Attach a device model to the bus.
+ *
+ * @param address Slave address of the device.
+ * @param device Model of the device.
+ */
+void i2c_sim_bus_t::attach(uint16_t address, i2c_sim_device_t& device)
+{
+    this->devices[address] = &device;
+}
+
+/**
+ * @brief Remove a device model from the bus. Messages to its address will not be acknowledged.
+ *
+ * @param address Slave address of the device.
+ */
+void i2c_sim_bus_t::detach(uint16_t address)
+{
+    this->devices.erase(address);
+}
+
+/**
+ * @brief Initialise the simulated bus. No character device is opened.
+ */
+void i2c_sim_bus_t::initialise()
+{
+    assert(initialised == 0u);
+
+    this->initialised = 1u;
+}
+
+/**
+ * @brief Read from a device model, like i2c_ioctl_read: the internal address is written first, in the same transfer.
+ */
+ssize_t i2c_sim_bus_t::read(const I2CDevice* device, uint32_t internal_address, uint8_t* buffer, size_t size)
+{
+    uint8_t address[4];
+    struct i2c_msg messages[2];
+    uint32_t count = 0u;
+
+    i2c_iaddr_convert(internal_address, device->iaddr_bytes, address);
+
+    if (device->iaddr_bytes)
+    {
+        messages[count++] = { device->addr, device->flags, (uint16_t)device->iaddr_bytes, address };
+    }
+
+    messages[count++] = { device->addr, (uint16_t)(device->flags | I2C_M_RD), (uint16_t)size, buffer };
+
+    return this->transfer(messages, count) == -1 ? -1 : size;
+}
+
+/**
+ * @brief Write to a device model, like i2c_ioctl_write: the data is split into pages,
+ * each page is a message that starts with the internal address.
+ */
+ssize_t i2c_sim_bus_t::write(const I2CDevice* device, uint32_t internal_address, const uint8_t* data, size_t size)
+{
+    std::vector<uint8_t> buffer;
+    size_t written = 0u;
+
+    while (written < size)
+    {
+        const size_t offset = internal_address % device->page_bytes;
+        const size_t chunk = offset + (size - written) > device->page_bytes ? device->page_bytes - offset : size - written;
+
+        buffer.assign(device->iaddr_bytes, 0u);
+        i2c_iaddr_convert(internal_address, device->iaddr_bytes, buffer.data());
+        buffer.insert(buffer.end(), data + written, data + written + chunk);
+
+        struct i2c_msg message = { device->addr, device->flags, (uint16_t)buffer.size(), buffer.data() };
+
+        if (this->transfer(&message, 1u) == -1)
+        {
+            return -1;
+        }
+
+        written += chunk;
+        internal_address += chunk;
+    }
+
+    return written;
+}
+
+/**
+ * @brief Pass messages to the device models. Fails if a device does not exist or does not acknowledge.
+ */
+int i2c_sim_bus_t::transfer(struct i2c_msg* messages, uint32_t count)
+{
+    assert(this->initialised == 1u);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto device = this->devices.find(messages[i].addr);
+
+        if (device == this->devices.end())
+        {
+            return -1;
+        }
+
+        const bool acknowledged = messages[i].flags & I2C_M_RD ?
+            device->second->i2c_sim_read(messages[i].buf, messages[i].len) :
+            device->second->i2c_sim_write(messages[i].buf, messages[i].len);
+
+        if (!acknowledged)
+        {
+            return -1;
+        }
+
+        this->transactions++;
+        this->bytes += messages[i].len;
+    }
+
+    return count;
+}
@@ -2,6 +2,8 @@
 
 #include <stdint.h>
 
+#include "../../../lib/libi2c/i2c.h"
+
 namespace pi_zero_peripherals
 {
 
@@ -9,13 +11,17 @@ class i2c_bus_t
 {
 public:
     i2c_bus_t(uint8_t bus_number);
-    ~i2c_bus_t();
+    virtual ~i2c_bus_t();
+
+    virtual void initialise();
 
-    void initialise();
+    virtual ssize_t read(const I2CDevice* device, uint32_t internal_address, uint8_t* buffer, size_t size);
+    virtual ssize_t write(const I2CDevice* device, uint32_t internal_address, const uint8_t* data, size_t size);
+    virtual int transfer(struct i2c_msg* messages, uint32_t count);
 
     uint8_t initialised;
     int bus_fd;
-private:
+protected:
     const uint8_t bus_number;
 };
 
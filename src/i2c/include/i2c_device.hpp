@@ -13,6 +13,7 @@ public:
 
     void i2c_read(uint8_t* buffer, uint8_t size, uint32_t internal_address = 0u);
     void i2c_write(uint8_t* data, uint8_t size, uint32_t internal_address = 0u);
+    void i2c_write_message(const uint8_t* data, uint16_t size);
 
     uint16_t flags;
 protected:
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+
+#include "i2c_bus.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Model of a device on a simulated I2C bus. Every call is a single I2C message (one transaction).
+ */
+class i2c_sim_device_t
+{
+public:
+    virtual ~i2c_sim_device_t() = default;
+
+    virtual bool i2c_sim_write(const uint8_t* data, uint16_t size) = 0;
+    virtual bool i2c_sim_read(uint8_t* buffer, uint16_t size) = 0;
+};
+
+/**
+ * @brief I2C bus that passes all messages to in-process device models instead of the kernel.
+ */
+class i2c_sim_bus_t : public i2c_bus_t
+{
+public:
+    i2c_sim_bus_t(uint8_t bus_number = 0u);
+    ~i2c_sim_bus_t();
+
+    void attach(uint16_t address, i2c_sim_device_t& device);
+    void detach(uint16_t address);
+
+    void initialise() override;
+
+    ssize_t read(const I2CDevice* device, uint32_t internal_address, uint8_t* buffer, size_t size) override;
+    ssize_t write(const I2CDevice* device, uint32_t internal_address, const uint8_t* data, size_t size) override;
+    int transfer(struct i2c_msg* messages, uint32_t count) override;
+
+    uint32_t transactions;
+    uint32_t bytes;
+private:
+    std::map<uint16_t, i2c_sim_device_t*> devices;
+};
+
+} /* pi_zero_peripherals */
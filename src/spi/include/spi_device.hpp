@@ -0,0 +1,38 @@
+#pragma once
+
+#include <linux/spi/spidev.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief Represents an SPI slave device in user space, accessed through spidev.
+ */
+class spi_device_t
+{
+public:
+    /* Default spidev buffer size (the bufsiz module parameter). A single transfer can not be larger. */
+    static constexpr uint32_t MAX_TRANSFER_SIZE = 4096u;
+    /* Transfers that are combined into one SPI_IOC_MESSAGE ioctl. */
+    static constexpr uint32_t MAX_TRANSFERS = 16u;
+
+    spi_device_t(uint8_t bus_number, uint8_t chip_select, uint32_t speed_hz = 8000000u, uint8_t mode = SPI_MODE_0);
+    virtual ~spi_device_t();
+
+    virtual void initialise();
+
+    void spi_write(const uint8_t* data, size_t size);
+    virtual int transfer(struct spi_ioc_transfer* transfers, uint32_t count);
+
+    uint8_t initialised;
+    int device_fd;
+protected:
+    const uint8_t bus_number;
+    const uint8_t chip_select;
+    const uint32_t speed_hz;
+    const uint8_t mode;
+};
+
+} /* pi_zero_peripherals */
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdexcept>
+
+namespace pi_zero_peripherals
+{
+
+class spi_device_exception: public std::runtime_error
+{
+public:
+    spi_device_exception(const std::string& message);
+};
+
+class spi_transfer_exception: public std::runtime_error
+{
+public:
+    spi_transfer_exception(const std::string& message);
+};
+
+} /* pi_zero_peripherals */
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "spi_device.hpp"
+
+namespace pi_zero_peripherals
+{
+
+/**
+ * @brief SPI device that records transfers instead of passing them to spidev, to test drivers without hardware.
+ */
+class spi_mock_device_t : public spi_device_t
+{
+public:
+    spi_mock_device_t(uint8_t bus_number = 0u, uint8_t chip_select = 0u);
+    ~spi_mock_device_t();
+
+    void initialise() override;
+    int transfer(struct spi_ioc_transfer* transfers, uint32_t count) override;
+
+    /* Called with the bytes of every transfer, e.g. to pass them to a device model. */
+    std::function<void(const uint8_t* data, uint32_t size)> on_transfer;
+    /* Bytes written in each transfer. */
+    std::vector<std::vector<uint8_t>> transfers;
+    uint32_t ioctls;
+    uint32_t bytes;
+};
+
+} /* pi_zero_peripherals */
@@ -0,0 +1,131 @@
+/**
+ * @file spi_device.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the spi_device_t class that represents an SPI slave device.
+ *        The bus number and chip select are used to open the correct spidev character device file.
+ *        Writes are done with SPI_IOC_MESSAGE, which queues several transfers in a single ioctl,
+ *        so a write that is larger than the spidev buffer still costs only one system call.
+ * @date 18-10-2026
+ */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <string>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "include/spi_device.hpp"
+#include "include/spi_exception.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new spi_device_t object.
+ *
+ * @param bus_number Number of the SPI bus.
+ * @param chip_select Chip select line of the device on the bus.
+ * @param speed_hz Clock speed in Hz (default: 8 MHz).
+ * @param mode SPI mode (clock polarity and phase) of the device (default: SPI_MODE_0).
+ */
+spi_device_t::spi_device_t(uint8_t bus_number, uint8_t chip_select, uint32_t speed_hz, uint8_t mode) :
+    initialised(0u),
+    device_fd(-1),
+    bus_number(bus_number),
+    chip_select(chip_select),
+    speed_hz(speed_hz),
+    mode(mode)
+{}
+
+/**
+ * @brief Destroy the spi_device_t object.
+ * Closes the spidev character device file.
+ */
+spi_device_t::~spi_device_t()
+{
+    if (this->device_fd != -1)
+    {
+        close(this->device_fd);
+    }
+}
+
+/**
+ * @brief Initialises the device by opening the spidev file and configuring mode, word size and clock speed.
+ */
+void spi_device_t::initialise()
+{
+    assert(this->initialised == 0u);
+
+    const std::string file_name = "/dev/spidev" + std::to_string(this->bus_number) + "." + std::to_string(this->chip_select);
+    const uint8_t bits_per_word = 8u;
+
+    this->device_fd = open(file_name.data(), O_RDWR);
+
+    if (this->device_fd == -1)
+    {
+        throw spi_device_exception("Could not open " + file_name);
+    }
+
+    if (ioctl(this->device_fd, SPI_IOC_WR_MODE, &this->mode) == -1 ||
+        ioctl(this->device_fd, SPI_IOC_WR_BITS_PER_WORD, &bits_per_word) == -1 ||
+        ioctl(this->device_fd, SPI_IOC_WR_MAX_SPEED_HZ, &this->speed_hz) == -1)
+    {
+        throw spi_device_exception("Could not configure " + file_name);
+    }
+
+    this->initialised = 1u;
+}
+
+/**
+ * @brief Write data to the device. The data is split into transfers of at most MAX_TRANSFER_SIZE bytes,
+ * which are queued in as few ioctls as possible. Chip select stays asserted between the transfers.
+ *
+ * @param data Data to write.
+ * @param size Size of the data to write.
+ */
+void spi_device_t::spi_write(const uint8_t* data, size_t size)
+{
+    struct spi_ioc_transfer transfers[MAX_TRANSFERS];
+    uint32_t count = 0u;
+
+    assert(this->initialised == 1u);
+
+    memset(transfers, 0, sizeof(transfers));
+
+    for (size_t written = 0u; written < size; written += MAX_TRANSFER_SIZE)
+    {
+        const size_t chunk = size - written < MAX_TRANSFER_SIZE ? size - written : MAX_TRANSFER_SIZE;
+        const bool last = written + chunk == size;
+
+        transfers[count].tx_buf = (uintptr_t)(data + written);
+        transfers[count].len = chunk;
+        transfers[count].speed_hz = this->speed_hz;
+        transfers[count].bits_per_word = 8u;
+        /* Keep the chip selected until the last transfer of the write. */
+        transfers[count].cs_change = 0u;
+        count++;
+
+        if (count == MAX_TRANSFERS || last)
+        {
+            if (this->transfer(transfers, count) == -1)
+            {
+                throw spi_transfer_exception("unable to write to SPI device");
+            }
+
+            memset(transfers, 0, sizeof(transfers));
+            count = 0u;
+        }
+    }
+}
+
+/**
+ * @brief Perform a sequence of transfers with a single SPI_IOC_MESSAGE ioctl.
+ *
+ * @param transfers Transfers to perform.
+ * @param count Number of transfers.
+ * @return int Number of bytes transferred, or -1 on failure.
+ */
+int spi_device_t::transfer(struct spi_ioc_transfer* transfers, uint32_t count)
+{
+    return ioctl(this->device_fd, SPI_IOC_MESSAGE(count), transfers);
+}
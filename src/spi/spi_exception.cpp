@@ -0,0 +1,28 @@
+/**
+ * @file spi_exception.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains various exceptions for SPI operations.
+ * @date 18-10-2026
+ */
+
+#include "include/spi_exception.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new spi_device_exception object. Used when a spidev character device file cannot be opened or configured.
+ *
+ * @param message Error message.
+ */
+spi_device_exception::spi_device_exception(const std::string& message) :
+    runtime_error(message)
+{}
+
+/**
+ * @brief Construct a new spi_transfer_exception object. Used when unable to transfer via SPI.
+ *
+ * @param message Error message.
+ */
+spi_transfer_exception::spi_transfer_exception(const std::string& message) :
+    runtime_error(message)
+{}
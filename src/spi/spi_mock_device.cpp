@@ -0,0 +1,71 @@
+/**
+ * @file spi_mock_device.cpp
+ * @author Marco van Eerden (mavaneerden@gmail.com)
+ * @brief Contains the spi_mock_device_t class, a spidev replacement for testing devices without hardware.
+ * @date 18-10-2026
+ */
+
+#include <assert.h>
+
+#include "include/spi_mock_device.hpp"
+
+using namespace pi_zero_peripherals;
+
+/**
+ * @brief Construct a new spi_mock_device_t object.
+ *
+ * @param bus_number Number of the simulated bus. Only used for identification.
+ * @param chip_select Chip select line of the simulated device. Only used for identification.
+ */
+spi_mock_device_t::spi_mock_device_t(uint8_t bus_number, uint8_t chip_select) :
+    spi_device_t(bus_number, chip_select),
+    ioctls(0u),
+    bytes(0u)
+{}
+
+/**
+ * @brief Destroy the spi_mock_device_t object. There is no file to close.
+ */
+spi_mock_device_t::~spi_mock_device_t()
+{
+    this->device_fd = -1;
+}
+
+/**
+ * @brief Initialise the mock device. No character device is opened.
+ */
+void spi_mock_device_t::initialise()
+{
+    assert(this->initialised == 0u);
+
+    this->initialised = 1u;
+}
+
+/**
+ * @brief Record the transfers of a single ioctl.
+ */
+int spi_mock_device_t::transfer(struct spi_ioc_transfer* transfers, uint32_t count)
+{
+    int transferred = 0;
+
+    assert(this->initialised == 1u);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* data = (const uint8_t*)(uintptr_t)transfers[i].tx_buf;
+
+        this->transfers.emplace_back(data, data + transfers[i].len);
+
+        if (this->on_transfer)
+        {
+            this->on_transfer(data, transfers[i].len);
+        }
+
+        this->bytes += transfers[i].len;
+        transferred += transfers[i].len;
+    }
+
+    this->ioctls++;
+
+    return transferred;
+}